@@ -2,6 +2,8 @@
 
 /* memory management */
 #include "memory.h"
+#include "arena.h" /* arena allocator */
+#include "slab.h" /* slab allocator */
 
 /* lexer and parser objects */
 #include "token.h"
@@ -19,6 +21,10 @@
 /* interpreter */
 #include "interpreter.h"
 
+/* bytecode compiler and vm */
+#include "compiler.h"
+#include "vm.h"
+
 /* errors */
 #include "error.h"
 
@@ -27,10 +33,18 @@
 #include "datatypes.h" /* simple data types such as int which is dependent on system version */
 #include "os.h" /* determine stuff like compiler and target os information */
 #include "run.h" /* run file */
+#include "module.h" /* loaded files */
+#include "cache.h" /* trees on disk */
 
 /* object storage */
 #include "storage.h"
 #include "names.h"
+#include "gc.h" /* garbage collector */
 
 /* io */
-#include "objectio.h"
\ No newline at end of file
+#include "objectio.h"
+
+/* builtins */
+#include "strlib.h" /* string functions */
+#include "veclib.h" /* vector functions */
+#include "maplib.h" /* map functions */
\ No newline at end of file
@@ -0,0 +1,51 @@
+/* arena allocator. memory is handed out from large blocks
+one after the other, and everything in an arena is freed at
+once when the arena is freed, so many small allocations that
+live as long as each other (such as the tokens of a file) only
+cost a handful of mallocs. an arena can also be used as a
+region: a mark is taken, and releasing back to it later frees
+everything allocated since, in one go. */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+#define ARENA_BLOCK_SIZE 65536 /* default size of a block */
+#define ARENA_ALIGN 8 /* every allocation starts on a multiple of this */
+
+/* block of memory, followed directly by its data */
+typedef struct _ADAMITE_Lib_ArenaBlock {
+	struct _ADAMITE_Lib_ArenaBlock *next; /* block that was filled before this one */
+	int used; /* number of bytes handed out */
+	int cap; /* number of bytes in the block */
+	double align; /* keeps the data that follows aligned */
+} arenaBlock;
+
+typedef struct _ADAMITE_Lib_Arena {
+	arenaBlock *head; /* block being handed out from */
+	arenaBlock *spare; /* released block kept for the next one that is needed, or NULL */
+	int block_sz; /* size of new blocks */
+} arena;
+
+/* position in an arena to release back to */
+typedef struct _ADAMITE_Lib_ArenaMark {
+	arenaBlock *block; /* block being handed out from, NULL if there was none */
+	arenaBlock *next; /* block behind it */
+	int used; /* number of bytes it had handed out */
+} arenaMark;
+
+arena *ARENA_NewArena(int block_sz); /* create a new arena */
+void ARENA_FreeArena(arena *a); /* free an arena and everything in it */
+void *ARENA_Alloc(arena *a, int sz); /* allocate memory that lives until the arena is freed */
+char *ARENA_CopyString(arena *a, const char *s, int len); /* copy len chars and a null term into the arena */
+arenaMark ARENA_Mark(arena *a); /* current position of an arena */
+void ARENA_Release(arena *a, arenaMark m); /* free everything allocated since a mark */
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
+
+#endif /* ARENA_H */
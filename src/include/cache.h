@@ -0,0 +1,62 @@
+/* cache of parsed trees on disk. after a file is parsed, its
+tree is written next to it in a file with the same name and a
+'c' on the end (test.adm -> test.admc). the next time the file
+is loaded, the tree is read from the cache instead of lexing and
+parsing the file again. the cache holds a hash and the length of
+the text that it was made from, so it is only used if the file
+hasn't changed. the cache is written to a temporary file and then
+renamed over the old one, so runs of the same file at the same time
+never see or make a partial cache.
+
+layout, where every number is written in as few bytes as it
+needs (7 bits per byte, high bit set if more bytes follow, sign
+in the lowest bit), since most of them are small:
+		"ADMC", version, hash of text, length of text
+		nodes, each one followed by its tokens and then its children:
+			node:  type, lineno, colno, b, vtype, c, d, n_of_toks, n_of_children
+			token: type, id, lineno, colno, length of value (-1 if NULL),
+			       value and null term
+the nodes and tokens of a loaded tree are allocated in an arena,
+and the values of its tokens point into the buffer that the cache
+was read into, so both must be kept with the tree. */
+#include "node.h" /* trees */
+#include "arena.h" /* arenas */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+#define CACHE_VERSION 9 /* changed whenever the layout or the nodes made by the parser change */
+
+/* buffer being written or read */
+typedef struct _ADAMITE_Lib_CacheBuffer {
+	char *buf; /* bytes */
+	int pos; /* position of the next read */
+	int sz; /* number of bytes */
+	int cap; /* capacity of bytes (writing only) */
+	int err; /* 1 if a read went past the end */
+} cacheBuffer;
+
+#ifndef __cplusplus
+int CACHE_Enabled; /* 0 if trees are never read from or written to the disk */
+#else
+extern int CACHE_Enabled; /* defined in cache.c for c++ */
+#endif
+
+node *CACHE_Load(const char *path, const char *text, char **buf, arena **a); /* tree of a file from its cache, or NULL; *buf and *a are set to the buffer and arena that hold it */
+void CACHE_Save(const char *path, const char *text, node *tree); /* write the cache of a file; errors are ignored */
+char *CACHE_Path(const char *path); /* name of the cache file of a file, in a new buffer */
+void CACHE_WriteInt(cacheBuffer *c, int x); /* add a number */
+void CACHE_WriteBytes(cacheBuffer *c, const char *s, int len); /* add bytes */
+void CACHE_WriteNode(cacheBuffer *c, node *n); /* add a node, its tokens and its children */
+int CACHE_ReadInt(cacheBuffer *c); /* read a number, sets err past the end */
+node *CACHE_ReadNode(arena *a, cacheBuffer *c); /* read a node, its tokens and its children */
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
+
+#endif /* CACHE_H */
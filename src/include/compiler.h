@@ -0,0 +1,60 @@
+/* the compiler lowers a tree of nodes into a flat list of
+instructions that can be run by the vm. example:
+		puts 1 + x; -> INT 1, LOAD x, BINARY +, PRINT
+*/
+#include "node.h" /* nodes */
+
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+/* opcodes; the operands that follow each opcode are listed beside it */
+#define OP_INT				0	/* value					push a new int				*/
+#define OP_STRING			1	/* node						push a new string			*/
+#define OP_LOAD				2	/* node						push a variable's value		*/
+#define OP_DECLARE			3	/* node						declare variable with top	*/
+#define OP_BINARY			4	/* node						binary operation on top two	*/
+#define OP_NEGATE			5	/* node						negate top					*/
+#define OP_PRINT			6	/* 							print top					*/
+#define OP_POP				7	/* 							discard top					*/
+#define OP_JUMP				8	/* target					jump to instruction			*/
+#define OP_JUMP_IF_FALSE	9	/* target					pop top, jump if false		*/
+#define OP_CALL				10	/* node, n_of_args			call a function				*/
+#define OP_GETITEM			11	/* node						get item at index top		*/
+#define OP_SETITEM			12	/* node						set item at index			*/
+#define OP_ADDRESS			13	/* 							address of top				*/
+#define OP_VALUE			14	/* node						object at address top		*/
+#define OP_SIZEOF			15	/* node						size of top					*/
+#define OP_FOR_INIT			16	/* node						start a for loop			*/
+#define OP_FOR_NEXT			17	/* node, target				next iteration or jump		*/
+#define OP_FOR_END			18	/* 							finish a for loop			*/
+#define OP_VISIT			19	/* node						visit node with tree walker	*/
+#define OP_RETURN			20	/* 							return top					*/
+#define OP_ASSIGN			21	/* node						assign top to variable		*/
+#define OP_JUMP_IF_NOT		22	/* node, target				compare top two, jump if false */
+
+typedef struct _ADAMITE_Lib_Chunk { /* compiled code */
+	int *code; /* opcodes and their operands */
+	node **nodes; /* nodes referred to by instructions */
+	int n_of_code; /* number of ints in code */
+	int code_cap; /* capacity of code */
+	int n_of_nodes; /* number of nodes */
+	int nodes_cap; /* capacity of nodes */
+} chunk;
+
+chunk *COMPILER_Compile(node *n); /* compile a node into a new chunk */
+void COMPILER_FreeChunk(chunk *c); /* free a chunk */
+void COMPILER_CompileNode(chunk *c, node *n); /* compile a node onto the end of a chunk */
+int COMPILER_Emit(chunk *c, int x); /* add an int to the code, returns its position */
+int COMPILER_AddNode(chunk *c, node *n); /* add a node to the chunk, returns its index */
+int COMPILER_CompileCondition(chunk *c, node *n); /* compile a condition and a jump taken if it is false, returns the position of the jump's target */
+void COMPILER_PrintChunk(chunk *c); /* print the instructions of a chunk (debug only) */
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
+
+#endif /* COMPILER_H */
@@ -0,0 +1,82 @@
+/* mark and sweep garbage collector for registered objects.
+Without it, every registered object is kept until the end of
+the program. The collector runs between statements once enough
+objects have been registered since the last collection, and
+frees the registered objects that can't be reached from a root.
+roots are:
+	- the values of all names
+	- the vm stacks of all interpreters that are running
+	- the locals in the frames of running functions
+	- values pushed with GC_PushRoot (values that are in use by
+	  the interpreter while other code is being run)
+arrays and instances keep their values alive, and an int keeps
+an object alive if it holds the object's address, since that is
+how pointers are stored. functions and structs are never freed. */
+#include "object.h" /* objects */
+#include "storage.h" /* registered objects */
+#include "interpreter.h" /* interpreter stacks */
+
+#ifndef GC_H
+#define GC_H
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+#define GC_MIN_THRESHOLD 4096 /* least number of registered objects before a collection */
+
+/* state of a collection */
+typedef struct _ADAMITE_Lib_GCMarker {
+	pointerSet marked; /* objects that have been reached */
+	object **work; /* reached objects that haven't been traced yet */
+	int work_sz; /* number of objects in work */
+	int work_cap; /* capacity of work */
+} gcMarker;
+
+#ifndef __cplusplus
+int GC_Enabled; /* 0 if objects are kept until the end of the program */
+int GC_Threshold; /* collect when this many objects are registered */
+object **GC_Roots; /* temporary roots */
+int GC_RootsSz; /* number of temporary roots */
+int GC_RootsCap; /* capacity of temporary roots */
+interpreter **GC_Interpreters; /* running interpreters */
+int GC_InterpretersSz; /* number of running interpreters */
+int GC_InterpretersCap; /* capacity of running interpreters */
+int GC_Collections; /* number of collections */
+int GC_Freed; /* number of objects freed by the collector */
+int GC_PeakHeap; /* most objects registered at once */
+double GC_TotalPause; /* time spent collecting, in seconds */
+double GC_MaxPause; /* longest collection, in seconds */
+#else
+extern int GC_Enabled; /* defined in gc.c for c++ */
+extern int GC_Threshold;
+extern object **GC_Roots;
+extern int GC_RootsSz;
+extern int GC_RootsCap;
+extern interpreter **GC_Interpreters;
+extern int GC_InterpretersSz;
+extern int GC_InterpretersCap;
+extern int GC_Collections;
+extern int GC_Freed;
+extern int GC_PeakHeap;
+extern double GC_TotalPause;
+extern double GC_MaxPause;
+#endif
+
+void GC_Init(); /* initialise the collector */
+void GC_FreeAll(); /* free the collector's lists */
+void GC_PushRoot(object *o); /* keep an object alive until it is popped */
+void GC_PopRoots(int sz); /* pop temporary roots until there are sz left */
+void GC_AddInterpreter(interpreter *i); /* scan an interpreter's stack and frames for roots */
+void GC_RemoveInterpreter(interpreter *i); /* stop scanning an interpreter's stack and frames */
+void GC_Check(); /* collect if the threshold has been reached; only call where every value in use is a root */
+void GC_Collect(); /* free every registered object that can't be reached */
+void GC_Mark(gcMarker *m, object *o); /* mark an object as reached */
+void GC_Trace(gcMarker *m, object *o); /* mark the objects that an object refers to */
+void GC_PrintStats(); /* print collection statistics */
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
+
+#endif /* GC_H */
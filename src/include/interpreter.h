@@ -12,8 +12,22 @@ extern "C" {
 
 typedef struct _ADAMITE_Lib_Interpreter {
 	error *e; /* current error */
+	object **stack; /* value stack (vm only) */
+	int sp; /* number of values on the stack */
+	int stack_cap; /* capacity of the stack */
+	object **frame; /* slots of the locals of running functions */
+	int fp; /* first slot of the current function's locals */
+	int frame_sz; /* number of slots in use */
+	int frame_cap; /* capacity of the slots */
 } interpreter;
 
+/* names of the locals of a function while it is being resolved */
+typedef struct _ADAMITE_Lib_Scope {
+	char **names; /* names of locals, the arguments come first */
+	int n_of_names; /* number of locals */
+	int names_cap; /* capacity of names */
+} scope;
+
 interpreter *INTERPRETER_NewInterpreter(); /* create new interpreter */
 void INTERPRETER_FreeInterpreter(interpreter *i); /* free interpreter */
 object *INTERPRETER_VisitNumber(interpreter *i, node *n); /* visit a number */
@@ -23,6 +37,7 @@ object *INTERPRETER_VisitUnOp(interpreter *i, node *n); /* visit a unary operati
 object *INTERPRETER_VisitPrint(interpreter *i, node *n); /* visit a print statement */
 object *INTERPRETER_VisitStatements(interpreter *i, node *n); /* visit multiple statements */
 object *INTERPRETER_VisitVarAssign(interpreter *i, node *n); /* visit a variable assignment */
+object *INTERPRETER_VisitAssign(interpreter *i, node *n); /* visit an assignment to an existing variable */
 object *INTERPRETER_VisitVarAccess(interpreter *i, node *n); /* visit to access a variable's value */
 object *INTERPRETER_VisitSizeof(interpreter *i, node *n); /* sizeof value */
 object *INTERPRETER_VisitFuncDef(interpreter *i, node *n); /* function definition */
@@ -41,6 +56,34 @@ object *INTERPRETER_VisitNew(interpreter *i, node *n); /* dynamically allocate a
 object *INTERPRETER_VisitWhile(interpreter *i, node *n); /* while loop */
 object *INTERPRETER_Visit(interpreter *i, node *n); /* visit a node */
 
+/* operations shared by the tree walker and the vm; these take the already evaluated
+values of a node's children and free them when they are done */
+object *INTERPRETER_BinaryOp(interpreter *i, node *n, object *left, object *right); /* apply a binary operation */
+object *INTERPRETER_UnaryOp(interpreter *i, node *n, object *right); /* apply a unary operation */
+object *INTERPRETER_Declare(interpreter *i, node *n, object *o); /* declare a variable with a value */
+object *INTERPRETER_Assign(interpreter *i, node *n, object *o); /* give an existing variable a new value of its type */
+object *INTERPRETER_SizeOf(interpreter *i, node *n, object *o); /* size of a value */
+int INTERPRETER_Comparison(node *n); /* comparison (OBJECT_CMP_...) made by a node, or -1 if it isn't one */
+int INTERPRETER_Compare(interpreter *i, node *n, object *left, object *right); /* truth value of a comparison node, or -1 on error */
+int INTERPRETER_Condition(interpreter *i, node *n); /* evaluate a condition to 1 or 0, or -1 on error */
+object *INTERPRETER_Dereference(interpreter *i, node *n, object *value); /* object at an address */
+int INTERPRETER_ForRange(interpreter *i, node *n, object *so, object *eo, object *to, int *start, int *end, int *step); /* check the start, end and step of a for loop, returns 0 on error */
+object *INTERPRETER_GetItem(interpreter *i, node *n, object *chd); /* get item at index */
+object *INTERPRETER_SetItem(interpreter *i, node *n, object *chd, object *new_value); /* set item at index */
+object *INTERPRETER_GetCallable(interpreter *i, node *n); /* find the function or struct being called */
+int INTERPRETER_CheckArgument(interpreter *i, node *n, function *f, int k, object *o); /* type check an argument, returns 0 on error */
+object *INTERPRETER_CallFunction(interpreter *i, node *n, object *fobj, object **args); /* call a function with evaluated arguments */
+
+/* locals of functions are given a slot in the function's frame when the function is defined.
+nodes that name a local keep the slot + 1 in d; 0 means the name is global. every name declared
+in a body is a local, so a declaration can't change a global; assignment (x = ...) does that */
+int INTERPRETER_FindLocal(scope *s, char *name); /* slot of a local, -1 if it isn't local */
+int INTERPRETER_AddLocal(scope *s, char *name); /* give a name a slot if it doesn't have one, returns the slot */
+void INTERPRETER_CollectLocals(scope *s, node *n); /* give every name declared in a body a slot */
+void INTERPRETER_ResolveLocals(scope *s, node *n); /* store the slots of locals in the nodes that name them */
+object *INTERPRETER_GetName(interpreter *i, node *n); /* value of the variable named by a node, NULL if not defined */
+void INTERPRETER_SetName(interpreter *i, node *n, object *o); /* assign to the variable named by a node */
+
 #ifdef __cplusplus /* c++ check */
 }
 #endif
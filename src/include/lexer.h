@@ -3,6 +3,7 @@
 		puts "Hello, World!"; -> IDENT:puts STRING:Hello, World EOL:;
 */
 #include "token.h" /* lexer tokens */
+#include "arena.h" /* token storage */
 #include <string.h> /* strcmp */
 
 #ifndef LEXER_H
@@ -30,28 +31,6 @@ extern "C" {
 						  (c == ' ') ||\
 						  (c == '\n') ||\
 						  (c == (char)13))
-/* find out if a word is a keyword */
-#define is_keyword(w) ((is(w, "return")) ||\
-					   (is(w, "puts")) ||\
-					   (is(w, "if")) ||\
-					   (is(w, "for")) ||\
-					   (is(w, "while")) ||\
-					   (is(w, "to")) ||\
-					   (is(w, "fn")) ||\
-					   (is(w, "sizeof")) ||\
-					   (is(w, "end")) ||\
-					   (is(w, "if")) ||\
-					   (is(w, "struct")) ||\
-					   (is(w, "stdin")) ||\
-					   (is(w, "include")) ||\
-					   (is(w, "new")))
-/* find out if a word is a var declaration */
-#define is_var_decl(w) ((is(w, "int")) ||\
-					    (is(w, "float")) ||\
-					    (is(w, "char")) ||\
-					    (is(w, "str")) ||\
-					    (is(w, "inst")))
-
 typedef struct _ADAMITE_Lib_Lexer {
 	token **tokens; /* the tokens that are held at the end of processing code */
 	const char *text; /* the actual code that is passed in */
@@ -63,16 +42,19 @@ typedef struct _ADAMITE_Lib_Lexer {
 	int lineno; /* line */
 	int colno; /* column */
 	int err; /* boolean to tell if an error has been printed or not */
+	arena *a; /* tokens and their values, freed with the lexer */
 } lexer;
 
 lexer *LEXER_NewLexer(const char *text); /* allocate new lexer */
 token *LEXER_MakeString(lexer *l); /* lexer make a string */
 token *LEXER_MakeIdent(lexer *l); /* lexer make an ident */
+int LEXER_Keyword(const char *s, int len); /* TOKEN_ID_ of a keyword or type name, or TOKEN_ID_NONE */
 token *LEXER_MakeInt(lexer *l); /* lexer make an integer */
 void LEXER_MakeTokens(lexer *l); /* make the tokens from code */
 void LEXER_FreeLexer(lexer *l); /* free lexer */
 void LEXER_Advance(lexer *l); /* advance lexer to next char */
 void LEXER_AddToken(lexer *l, token *t); /* add a token to a lexer's token list */
+token *LEXER_NewToken(lexer *l, int type, const char *value, int lineno, int colno); /* create a token in the lexer's arena */
 
 #ifdef __cplusplus /* c++ check */
 }
@@ -0,0 +1,36 @@
+/* map functions written in c. they are assigned to their names
+when the program starts, like the string functions (see strlib.h):
+		mapnew() -> map				new empty map
+		mapset(m: map, key, x) -> x		set the value of key (same as m[key] = x)
+		mapget(m: map, key) -> x		value of key (same as m[key])
+		maphas(m: map, key) -> int		1 if key is in the map, otherwise 0
+		mapdel(m: map, key) -> int		remove key, returns 1 if it was there
+		maplen(m: map) -> int			number of keys
+		mapkeys(m: map) -> vec			vector of the keys, in no order
+keys are strings or ints, and values can be of any type. the keys
+of mapkeys are copies, so they can be changed without changing the
+map. if a map has both string and int keys, the vector of its keys
+takes values of any type. */
+#include "object.h" /* objects */
+
+#ifndef MAPLIB_H
+#define MAPLIB_H
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+void MAPLIB_Init(); /* assign the map functions to their names */
+object *MAPLIB_New(object **args, const char **err); /* mapnew */
+object *MAPLIB_Set(object **args, const char **err); /* mapset */
+object *MAPLIB_Get(object **args, const char **err); /* mapget */
+object *MAPLIB_Has(object **args, const char **err); /* maphas */
+object *MAPLIB_Del(object **args, const char **err); /* mapdel */
+object *MAPLIB_Len(object **args, const char **err); /* maplen */
+object *MAPLIB_Keys(object **args, const char **err); /* mapkeys */
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
+
+#endif /* MAPLIB_H */
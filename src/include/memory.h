@@ -1,5 +1,6 @@
 /* memory management macros. */
 #include <stdlib.h>
+#include "slab.h" /* small blocks */
 
 #ifndef MEMORY_H
 #define MEMORY_H
@@ -11,6 +12,8 @@ extern "C" {
 #define MEMORY_Malloc(type) (type*)(malloc(sizeof(type))) /* allocate an object */
 #define MEMORY_Free(obj) free((void*)obj) /* free an object from memory */
 #define MEMORY_Realloc(obj, sz) realloc(obj, sz) /* reallocate an object to new memory */
+#define MEMORY_SlabMalloc(type) (type*)(SLAB_Alloc(sizeof(type))) /* allocate a small object from the slabs (see slab.h) */
+#define MEMORY_SlabFree(obj, type) SLAB_Free((void*)obj, sizeof(type)) /* free an object allocated with MEMORY_SlabMalloc */
 
 #ifdef __cplusplus /* c++ check */
 }
@@ -0,0 +1,70 @@
+/* cache of the files that have been run or included. each
+file is read, lexed and parsed once, and its tree is kept
+until the end of the program. a file is found by its resolved
+path, so 'stdlib/string.adm' and './stdlib/string.adm' are the
+same module. if the file has changed on disk (different
+modification time or size) it is loaded again. trees are also
+kept on disk between runs (see cache.h).
+
+includes that aren't found relative to the current directory
+are searched for in the directories of the search path, which
+are added with the -I option and the ADAMITE_PATH environment
+variable (separated by ':', or ';' on windows). */
+#include "lexer.h" /* tokens */
+#include "parser.h" /* trees */
+#include "os.h" /* WINDOWS */
+
+#ifndef MODULE_H
+#define MODULE_H
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+#ifdef WINDOWS
+#define MODULE_PATH_SEP ';' /* separates directories in ADAMITE_PATH */
+#else
+#define MODULE_PATH_SEP ':' /* separates directories in ADAMITE_PATH */
+#endif
+
+typedef struct _ADAMITE_Lib_Module {
+	char *path; /* resolved path of the file */
+	long mtime; /* modification time of the file when it was loaded */
+	long size; /* size of the file when it was loaded */
+	char *text; /* text of the file */
+	lexer *l; /* tokens of the file, NULL if the tree came from the cache */
+	parser *p; /* parser of the file, NULL if the tree came from the cache or the file is empty */
+	node *tree; /* tree of the file, NULL if the file is empty */
+	char *cache; /* buffer that the cached tree was read into, otherwise NULL */
+	arena *a; /* nodes and tokens of the cached tree, otherwise NULL */
+	int ran; /* 1 once the top level of the file has been run */
+} module;
+
+#ifndef __cplusplus
+module **MODULE_Modules; /* loaded modules */
+int MODULE_ModulesSz; /* number of loaded modules */
+int MODULE_ModulesCap; /* capacity of loaded modules */
+char **MODULE_Paths; /* directories searched for includes */
+int MODULE_PathsSz; /* number of directories */
+int MODULE_PathsCap; /* capacity of directories */
+#else
+extern module **MODULE_Modules; /* defined in module.c for c++ */
+extern int MODULE_ModulesSz;
+extern int MODULE_ModulesCap;
+extern char **MODULE_Paths;
+extern int MODULE_PathsSz;
+extern int MODULE_PathsCap;
+#endif
+
+void MODULE_Init(); /* initialise the cache and search path */
+void MODULE_FreeAll(); /* free every module */
+void MODULE_AddPath(const char *dir); /* add a directory to the search path */
+void MODULE_AddPaths(const char *dirs); /* add a list of directories separated by MODULE_PATH_SEP */
+char *MODULE_Resolve(const char *fname); /* resolved path of a file, searching the search path; NULL if not found */
+module *MODULE_Load(const char *fname, int *code); /* find or load a module; on error, prints it, sets code and returns NULL */
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
+
+#endif /* MODULE_H */
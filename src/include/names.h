@@ -8,21 +8,34 @@
 extern "C" {
 #endif
 
+/* names are kept in an open addressing hash table. a slot
+is empty when it's name is NULL; names are never removed. */
+typedef struct _ADAMITE_Lib_NameEntry {
+	char *name; /* variable name */
+	unsigned int hash; /* cached hash of the name */
+	object *value; /* variable value */
+} nameEntry;
+
 #ifndef __cplusplus
-char **NAMES_VariableNames; /* variable names list */
-int NAMES_VariableNamesSz; /* length of variable names list */
-int NAMES_VariableNamesCap; /* capacity of variable names list */
-object **NAMES_Variables; /* variable value list */
-int NAMES_VariablesSz; /* length of variable value list */
-int NAMES_VariablesCap; /* capacity of variable value list */
+nameEntry *NAMES_Table; /* table of variables */
+int NAMES_TableSz; /* number of variables in table */
+int NAMES_TableCap; /* number of slots in table, always a power of two */
+#else
+extern nameEntry *NAMES_Table; /* defined in names.c for c++ */
+extern int NAMES_TableSz;
+extern int NAMES_TableCap;
 #endif
 
 void NAMES_Assign(char* name, object *o); /* add or assign a name */
-int NAMES_FindName(char *name); /* find a name, return the position of it */
+int NAMES_FindName(char *name); /* find a name, return the position of it (or the empty slot it would go in) */
 void NAMES_FreeAll(); /* free all names */
 void NAMES_Init(); /* init names list */
 void NAMES_PrintNames(); /* print all variable names (debug only) */
 object *NAMES_Get(char *name); /* get a value from a name */
+nameEntry *NAMES_Find(char *name, int *slot); /* entry of a name, NULL if not defined; slot remembers where it was (see node.h) */
+unsigned int NAMES_Hash(const char *name); /* hash a name */
+int NAMES_FindSlot(const char *name, unsigned int hash); /* find the slot for a name with a known hash */
+void NAMES_Grow(); /* double the size of the table */
 
 #ifdef __cplusplus /* c++ check */
 }
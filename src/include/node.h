@@ -1,4 +1,6 @@
 #include "token.h" /* node includes token array */
+#include "arena.h" /* node storage */
+#include <stdint.h> /* uint8_t */
 
 #ifndef NODE_H
 #define NODE_H
@@ -33,29 +35,39 @@ extern "C" {
 #define NODE_INCLUDE	23	/* run an external file				*/
 #define NODE_NEW		24	/* dynamically allocate object		*/
 #define NODE_WHILE		25	/* while loop						*/
+#define NODE_ASSIGN		26	/* assign to an existing variable	*/
 
+/* nodes, their lists of tokens and children, and copied tokens are
+all allocated in an arena, and are freed together when the arena is
+freed (nodes of a file belong to its parser, and nodes of a function
+body to the function). lists start empty and are doubled in size
+whenever the number of items reaches a power of two, so nodes don't
+need to keep their capacity. */
 typedef struct _ADAMITE_Lib_Node { /* parser nodes can be recursive */
-	int type; /* type of node */
+	uint8_t type; /* type of node */
+	uint8_t b; /* boolean value for related things */
+	uint8_t vtype; /* type named by the node's type token (OBJECT_ type), set by the parser */
 	token **tokens; /* tokens put in node */
 	struct _ADAMITE_Lib_Node **children; /* children of node */
 	unsigned int n_of_children; /* number of children */
 	unsigned int n_of_toks; /* number of tokens */
-	unsigned int n_children_cap; /* number of items that can be held in the array of children */
-	unsigned int n_toks_cap; /* number of items that can be held in the array of tokens */
 	int lineno; /* line number */
 	int colno; /* column number */
-	int b; /* boolean value for related things */
-	int c; /* other values */
+	union {
+		int c; /* other values (value of int literals, size of arrays) */
+		float f; /* value of float literals */
+	};
 	int d; /* other values */
+	int slot; /* slot + 1 of the global that the node names, remembered by NAMES_Find (0 if not known) */
 } node;
 
-node *NODE_NewNode(int type); /* allocate a new node */
-void NODE_FreeNode(node *n); /* free a node */
-void NODE_FreeChildren(node *n); /* free the node's children */
-node *NODE_AddChild(node *parent, node *child); /* add a child to a node */
-node *NODE_AddToken(node *parent, token *t); /* add a token */
-node *NODE_CopyNode(node *n); /* (made for functions) copy a node from parser to a node that is completely free from parser */
-void NODE_FreeCopyNode(node *n); /* free node that has been copied through function */
+#define NODE_ARENA_SIZE 4096 /* size of blocks for copied function bodies */
+
+node *NODE_NewNode(arena *a, int type); /* allocate a new node */
+node *NODE_AddChild(arena *a, node *parent, node *child); /* add a child to a node */
+node *NODE_AddToken(arena *a, node *parent, token *t); /* add a token */
+void **NODE_Grow(arena *a, void **list, unsigned int n); /* make room for one more item in a list of n items */
+node *NODE_CopyNode(arena *a, node *n); /* (made for functions) copy a node and its tokens into an arena that is completely free from parser */
 void NODE_PrintTree(node *n); /* print the tree of a node */
 int NODE_CheckNodeType(node *n); /* returns 1 if the node type is a known type, 0 if it is not */
 
@@ -2,7 +2,7 @@
 /* "interpreter's equivelant to nodes and tokens" */
 
 #include "node.h" /* for functions */
-#include <stdint.h> /* uint8_t type */
+#include <stdint.h> /* uint8_t, intptr_t types */
 
 #ifndef OBJECT_H
 #define OBJECT_H
@@ -20,26 +20,120 @@ extern "C" {
 #define OBJECT_FUNCTION		5
 #define OBJECT_STRUCT		6
 #define OBJECT_INSTANCE		7
+#define OBJECT_VECTOR		8
+#define OBJECT_MAP			9
+#define OBJECT_ANY			254 /* argument of a builtin that takes any type */
+#define OBJECT_NONE			255 /* no type (unknown type names) */
+
+/* type named by a type name token id (TOKEN_ID_INT...), resolved by the parser */
+#define OBJECT_TypeOfName(id) ((id) == TOKEN_ID_INT ? OBJECT_INT :\
+							   (id) == TOKEN_ID_CHAR ? OBJECT_CHAR :\
+							   (id) == TOKEN_ID_STR ? OBJECT_STRING :\
+							   (id) == TOKEN_ID_INST ? OBJECT_INSTANCE :\
+							   (id) == TOKEN_ID_VEC ? OBJECT_VECTOR :\
+							   (id) == TOKEN_ID_MAP ? OBJECT_MAP : OBJECT_NONE)
+
+/* ints and chars are not allocated; they are kept inside the
+object pointer itself. since allocated objects are aligned, the
+low two bits of their pointers are always 0, so those bits are
+used as a tag:
+		...xxxxx00 -> pointer to an allocated object
+		...xxxxx01 -> int, value is the rest of the bits
+		...xxxxx10 -> char, value is the rest of the bits
+ints that don't fit in the remaining bits are allocated like
+before. always use these macros instead of o->type and o->value
+for values that may be ints or chars. */
+#define OBJECT_TAG_INT		1
+#define OBJECT_TAG_CHAR		2
+#define OBJECT_IsImmediate(o) (((intptr_t)(o) & 3) != 0) /* int or char that isn't allocated */
+#define OBJECT_Immediate(x, tag) ((object*)(((uintptr_t)(intptr_t)(x) << 2) | (tag))) /* make an immediate */
+#define OBJECT_FitsImmediate(x) (sizeof(intptr_t) > sizeof(int) || ((x) >= -(1 << 29) && (x) < (1 << 29))) /* int can be an immediate */
+#define OBJECT_TypeOf(o) (OBJECT_IsImmediate(o) ? (((intptr_t)(o) & 3) == OBJECT_TAG_INT ? OBJECT_INT : OBJECT_CHAR) : (o)->type) /* type of object */
+#define OBJECT_IntValue(o) (OBJECT_IsImmediate(o) ? (int)((intptr_t)(o) >> 2) : *(int*)(o)->value) /* value of int or char */
+#define OBJECT_CharValue(o) ((char)OBJECT_IntValue(o)) /* value of char */
+
+/* string literals are made once and then shared by every
+evaluation of their node, instead of being copied each time. a
+shared object is never freed by OBJECT_FreeObject (so the usual
+'if (!STORAGE_Find(o)) OBJECT_FreeObject(o)' is still safe) and
+must never be changed in place. it is never registered either:
+STORAGE_Register returns a copy of it, so variables, arrays and
+instances always get their own string, and literals that are only
+read (operands, puts, arguments of builtins) are never copied.
+code that changes a string in place still copies it first if it is
+shared. shared objects are freed at the end of the program by
+OBJECT_FreeLiterals. */
+#define OBJECT_SHARED		1 /* flag for shared objects */
+#define OBJECT_IsShared(o) (!OBJECT_IsImmediate(o) && ((o)->flags & OBJECT_SHARED)) /* object is shared */
+
+/* a string made by an expression and then declared is seen only
+by its variable, until the variable is read, its address is taken
+or the string is stored somewhere else. while that is true, the
+string is owned, and 'str s = s + x;' appends to it in place
+instead of copying it (see INTERPRETER_BinaryOp). */
+#define OBJECT_OWNED		2 /* flag for owned strings */
+#define OBJECT_IsOwned(o) (!OBJECT_IsImmediate(o) && ((o)->flags & OBJECT_OWNED)) /* string is owned */
+#define OBJECT_Disown(o) ((o) != NULL && OBJECT_IsOwned(o) ? ((o)->flags &= ~OBJECT_OWNED) : 0) /* something else can see the string now */
+
+/* temporaries made in the scratch region live until the region is
+released, and are copied when registered (see storage.h) */
+#define OBJECT_SCRATCH		4 /* flag for objects in the scratch region */
+#define OBJECT_IsScratch(o) (!OBJECT_IsImmediate(o) && ((o)->flags & OBJECT_SCRATCH)) /* object is in the scratch region */
+
+/* comparisons, for OBJECT_Compare */
+#define OBJECT_CMP_EQ		0 /* '==' */
+#define OBJECT_CMP_NE		1 /* '!=' */
+#define OBJECT_CMP_LT		2 /* '<' */
+#define OBJECT_CMP_GT		3 /* '>' */
 
 /* base object type */
 typedef struct _ADAMITE_Lib_Object { /* base object type for variables */
 	uint8_t type; /* type of object */
+	uint8_t flags; /* OBJECT_SHARED, OBJECT_OWNED, OBJECT_SCRATCH */
 	void *value; /* pointer to the value */
 } object; /* final name */
-/* object array type */
+/* string type, with its chars in the same block after the header.
+the length is kept so strings are never rescanned, and there is
+room to append to the string without moving it most of the time.
+chars can be set anywhere in the buffer (up to cap) like a c
+string, so the length is the position of the first null term. */
+typedef struct _ADAMITE_Lib_StringObject {
+	int len; /* number of chars, not counting the null term */
+	int cap; /* number of chars that fit, not counting the null term */
+	unsigned int hash; /* hash of the chars, 0 if not known (see OBJECT_StringHash) */
+	char chars[1]; /* chars and null term */
+} stringObject; /* will be held in 'value' of object* */
+#define OBJECT_String(o) ((stringObject*)(o)->value) /* string of a string object */
+#define OBJECT_StringChars(o) (OBJECT_String(o)->chars) /* chars of a string object */
+#define OBJECT_StringLen(o) (OBJECT_String(o)->len) /* length of a string object */
+/* object array type. vectors are arrays that grow: they keep
+room for cap values, and the room is doubled with realloc when it
+runs out, so ints and chars stay in one buffer. the type of a
+vector is OBJECT_NONE until its first value is pushed. */
 typedef struct _ADAMITE_Lib_ArrayObject {
 	uint8_t array_type; /* the type of the array */
-	object **values; /* the values of the array */
+	object **values; /* the values of the array, NULL for int and char arrays */
+	int32_t *ints; /* the values of an int array, otherwise NULL */
+	char *chars; /* the values of a char array, otherwise NULL */
 	int size; /* the size of the array */
+	int cap; /* number of values there is room for (vectors only) */
 } arrayObject; /* will be held in 'value' of object* */
+/* builtin written in c. it gets the arguments of the call (already
+checked against the argument types) and returns a new object, or
+NULL with err set to the message of a runtime error */
+typedef struct _ADAMITE_Lib_Object *(*nativeFunction)(struct _ADAMITE_Lib_Object **args, const char **err);
 /* function type */
 typedef struct _ADAMITE_Lib_FunctionObject {
 	uint8_t ret_type; /* the return type of the function */
 	char **arg_names; /* the function argument names */
 	uint8_t *arg_types; /* the function argument types */
 	node *body_node; /* function body */
+	arena *body_arena; /* holds the copy of the body */
 	char *func_name; /* function name */
 	int n_of_args; /* number of function arguments */
+	int n_of_locals; /* number of slots in the function's frame, including arguments */
+	struct _ADAMITE_Lib_Chunk *code; /* compiled body, made on first call by the vm */
+	nativeFunction native; /* builtin written in c, otherwise NULL */
 } function;
 /* struct object */
 typedef struct _ADAMITE_Lib_StructObject {
@@ -53,25 +147,64 @@ typedef struct _ADAMITE_Lib_Instance {
 	structObject *st; /* actual struct */
 	object **values; /* actual struct values */
 } instance;
+/* map from string and int keys to values of any type, kept in one
+table with open addressing: a key is looked for from the slot of
+its hash onwards until an empty slot is reached. a slot with a hash
+of 0 is empty; a removed entry keeps its hash with a NULL key, so
+keys after it can still be found. the map keeps its own copy of
+each key (so keys can't be changed from outside), and values are
+registered like the values of arrays. */
+typedef struct _ADAMITE_Lib_MapEntry {
+	unsigned int hash; /* hash of the key, never 0 for a used slot */
+	object *key; /* key, NULL if the slot is empty or removed */
+	object *value; /* value of the key */
+} mapEntry;
+typedef struct _ADAMITE_Lib_MapObject {
+	mapEntry *entries; /* slots */
+	int cap; /* number of slots, always a power of 2 */
+	int sz; /* number of keys */
+	int used; /* number of slots that aren't empty, including removed entries */
+} mapObject;
+
+#ifndef __cplusplus
+object **OBJECT_Literals; /* shared string literals */
+int OBJECT_LiteralsSz; /* number of shared string literals */
+int OBJECT_LiteralsCap; /* capacity of shared string literals */
+#else
+extern object **OBJECT_Literals; /* defined in object.c for c++ */
+extern int OBJECT_LiteralsSz;
+extern int OBJECT_LiteralsCap;
+#endif
 
 object *OBJECT_NewObject(int type); /* instantiate a new object */
 object *OBJECT_NewArray(int type, int size); /* new array */
-object *OBJECT_NewFunction(char *func_name, int ret_type, char **arg_names, uint8_t *arg_types, int n_of_args, node *body_node); /* new function */
+object *OBJECT_NewFunction(char *func_name, int ret_type, char **arg_names, uint8_t *arg_types, int n_of_args, node *body_node, arena *body_arena); /* new function */
+object *OBJECT_NewNative(const char *func_name, int ret_type, const char **arg_names, const uint8_t *arg_types, int n_of_args, nativeFunction native); /* new builtin; the names and types are copied */
 object *OBJECT_AddedTo(object *self, object *other); /* add the value of an object to another object */
 object *OBJECT_SubbedBy(object *self, object *other); /* subtract */
 object *OBJECT_MultedBy(object *self, object *other); /* multiply */
 object *OBJECT_DivedBy(object *self, object *other); /* divide (not by zero) */
 object *OBJECT_ModdedBy(object *self, object *other); /* modulo (get remainder of division) */
+int OBJECT_Compare(object *self, object *other, int cmp); /* 1 or 0 for a comparison (OBJECT_CMP_...), -1 if the values can't be compared */
 object *OBJECT_IsEqualTo(object *self, object *other); /* == */
 object *OBJECT_IsNotEqualTo(object *self, object *other); /* != */
+int OBJECT_StringEquals(object *self, object *other); /* 1 if two strings have the same chars */
 object *OBJECT_IsGreaterThan(object *self, object *other); /* > */
 object *OBJECT_IsLessThan(object *self, object *other); /* < */
 object *OBJECT_IsGreaterThanOrEqualTo(object *self, object *other); /* >= */
 object *OBJECT_IsLessThanOrEqualTo(object *self, object *other); /* <= */
-object *OBJECT_IsTrue(object *self); /* object's truth value */
+int OBJECT_Truth(object *self); /* object's truth value, 1 or 0 */
+object *OBJECT_IsTrue(object *self); /* object's truth value, as a new int */
 object *OBJECT_PowedBy(object *self, object *other); /* exponent */
 object *OBJECT_NewString(const char *s); /* new string */
+object *OBJECT_NewStringLen(const char *s, int len); /* new string of len chars; if s is NULL the chars are left for the caller to fill */
+void OBJECT_StringAppend(object *o, const char *s, int len); /* add len chars to the end of a string, growing it if needed */
+unsigned int OBJECT_StringHash(object *o); /* hash of a string, worked out the first time */
+object *OBJECT_Literal(node *n); /* shared string of a string literal node, made the first time it is used */
+void OBJECT_FreeLiterals(); /* free every shared string literal */
 object *OBJECT_NewInt(int i); /* new integer */
+object *OBJECT_TempInt(int i); /* new integer in the scratch region */
+object *OBJECT_TempString(int len); /* new string of len chars in the scratch region, left for the caller to fill */
 object *OBJECT_NewChar(char c); /* new char */
 object *OBJECT_NewFloat(float f); /* new float */
 object *OBJECT_NewPtr(int addr); /* new pointer to a variable */
@@ -79,9 +212,21 @@ object *OBJECT_NewStruct(char *name, uint8_t *val_types, char **val_names, int n
 object *OBJECT_NewInstance(structObject *st); /* create an instance */
 void OBJECT_FreeObject(object *o); /* free an object's memory */
 void OBJECT_FreeArray(arrayObject *o); /* free an array object's memory */
+object *OBJECT_NewVector(); /* new empty vector */
+void OBJECT_VectorReserve(arrayObject *o, int cap); /* make room for cap values */
+int OBJECT_VectorPush(arrayObject *o, object *value); /* add a value to the end, returns 0 if the type doesn't fit */
+object *OBJECT_GetArrayItem(arrayObject *o, int idx); /* get the value at an index; a new object for int and char arrays */
+int OBJECT_SetArrayItem(arrayObject *o, int idx, object *value); /* set the value at an index, returns 0 if the type doesn't fit */
 void OBJECT_FreeStruct(structObject *o); /* free a struct */
 void OBJECT_FreeInstance(instance *o); /* free a struct instance */
-int OBJECT_StringLength(arrayObject *o); /* find the length of a char array */
+object *OBJECT_NewMap(); /* new empty map */
+int OBJECT_IsKey(object *key); /* 1 if a value can be a key of a map (a string or an int) */
+unsigned int OBJECT_MapHash(object *key); /* hash of a key, never 0 */
+mapEntry *OBJECT_MapFind(mapObject *o, object *key); /* entry of a key, or NULL */
+void OBJECT_MapSet(mapObject *o, object *key, object *value); /* set the value of a key, adding a copy of the key if it is new */
+int OBJECT_MapRemove(mapObject *o, object *key); /* remove a key, returns 0 if it wasn't there */
+void OBJECT_FreeMap(mapObject *o); /* free the keys and entries of a map */
+int OBJECT_StringLength(arrayObject *o); /* find the length of the string in a char array */
 
 #ifdef __cplusplus /* c++ check */
 }
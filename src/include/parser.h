@@ -3,6 +3,7 @@ a tree of nodes. */
 #include "node.h" /* nodes */
 #include "token.h" /* tokens */
 #include "error.h" /* errors */
+#include "arena.h" /* node storage */
 
 #ifndef PARSER_H
 #define PARSER_H
@@ -18,6 +19,7 @@ typedef struct _ADAMITE_Lib_Parser { /* actual struct for parser */
 	error *e; /* current error */
 	int pos; /* position in token list */
 	unsigned int n_of_toks; /* number of tokens */
+	arena *a; /* nodes, freed with the parser */
 } parser;
 
 parser *PARSER_NewParser(token **tokens, unsigned int n_of_toks); /* create a new parser */
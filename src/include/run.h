@@ -1,4 +1,6 @@
 /* for running files */
+#include "node.h" /* trees */
+
 #ifndef RUN_H
 #define RUN_H
 
@@ -6,7 +8,18 @@
 extern "C" {
 #endif
 
+#define RUN_TREE 0 /* walk the tree of nodes (default) */
+#define RUN_VM 1 /* compile the tree and run it on the vm */
+
+#ifndef __cplusplus
+int RUN_Mode; /* how code is executed */
+#else
+extern int RUN_Mode; /* defined in run.c for c++ */
+#endif
+
 int run(const char *fname); /* run the code in a file; returns 0 if no error, 1 if error */
+int include(const char *fname); /* run the code in a file unless it has already been run; returns the same as run */
+int RUN_Tree(node *n); /* run a parsed tree on a new interpreter; returns the same as run */
 
 #ifdef __cplusplus /* c++ check */
 }
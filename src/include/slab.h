@@ -0,0 +1,56 @@
+/* slab allocator for the small blocks that objects are made of
+(object headers, int and float values, arrays, instances and maps).
+the interpreter makes and frees these all the time, and they come in
+only a few sizes, so instead of going to malloc each block comes from
+a size class: blocks are handed out one after the other from large
+slabs, and freed blocks are kept on a list for their class and handed
+out again first. blocks bigger than the largest class go to malloc.
+slabs are only given back at the end of the program. */
+
+#ifndef SLAB_H
+#define SLAB_H
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+#define SLAB_GRANULE 8 /* sizes of classes are multiples of this */
+#define SLAB_CLASSES 8 /* number of classes, so the largest is 64 bytes */
+#define SLAB_SIZE 65536 /* bytes in a slab */
+
+/* slab, followed directly by its blocks */
+typedef struct _ADAMITE_Lib_SlabBlock {
+	struct _ADAMITE_Lib_SlabBlock *next; /* slab that was made before this one */
+	double align; /* keeps the blocks that follow aligned */
+} slabBlock;
+
+/* blocks of one size */
+typedef struct _ADAMITE_Lib_SlabClass {
+	void *free; /* freed blocks, each holding a pointer to the next */
+	char *next; /* next block of the newest slab that hasn't been handed out */
+	char *end; /* end of the newest slab */
+	int in_use; /* number of blocks handed out and not freed */
+	int peak; /* largest in_use */
+	int slabs; /* number of slabs */
+} slabClass;
+
+#ifndef __cplusplus
+slabClass SLAB_Classes[SLAB_CLASSES]; /* size classes, smallest first */
+slabBlock *SLAB_Blocks; /* every slab, newest first */
+int SLAB_Large; /* blocks too big for a class that were handed out and not freed */
+#else
+extern slabClass SLAB_Classes[SLAB_CLASSES]; /* defined in slab.c for c++ */
+extern slabBlock *SLAB_Blocks;
+extern int SLAB_Large;
+#endif
+
+void *SLAB_Alloc(int sz); /* allocate a block of sz bytes */
+void SLAB_Free(void *p, int sz); /* free a block, sz must be the size it was allocated with */
+void SLAB_FreeAll(); /* free every slab, at the end of the program */
+void SLAB_PrintStats(); /* print the blocks in use of each class */
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
+
+#endif /* SLAB_H */
@@ -5,7 +5,20 @@ been freed. when the debug constant is
 defined, it will print out all of the memory
 addresses that haven't been freed already. */
 
+/* temporaries made while a statement is evaluated (the results of
+arithmetic and of joining strings) are made in the scratch region
+instead of one by one on the heap, and flagged OBJECT_SCRATCH. they
+are never freed on their own: INTERPRETER_VisitStatements marks the
+region before each statement and releases it once the statement is
+done (loops release it after each turn, and the vm at each
+OP_POP), so everything the statement made goes at once. a temporary
+that escapes is registered, and STORAGE_Register gives back a copy
+of it on the heap, just like for shared literals. the value of the
+last statement of a block isn't released, since it is given to
+whatever ran the block. */
+
 #include "object.h" /* header for objects */
+#include "arena.h" /* scratch region */
 
 #ifndef STORAGE_H
 #define STORAGE_H
@@ -16,13 +29,25 @@ extern "C" {
 
 #define STORAGE_DEBUG 0 /* determine if we want to debug */
 
+/* set of pointers, stored in an open addressing hash table
+so that checking for a pointer doesn't depend on how many
+objects have been registered. */
+typedef struct _ADAMITE_Lib_PointerSet {
+	object **keys; /* slots, NULL if empty */
+	int sz; /* number of pointers in set */
+	int cap; /* number of slots, always a power of two */
+} pointerSet;
+
 #ifndef __cplusplus
-object **STORAGE_ObjectPointers; /* object pointers */
-object **STORAGE_FreedPointers; /* freed pointers */
-int STORAGE_ObjectPointersSz; /* size of object pointers list */
-int STORAGE_FreedPointersSz; /* size of freed pointers list */
-int STORAGE_ObjectPointersCap; /* capacity of object pointers list */
-int STORAGE_FreedPointersCap; /* capacity of freed pointers list */
+pointerSet STORAGE_ObjectPointers; /* object pointers */
+pointerSet STORAGE_FreedPointers; /* freed pointers */
+pointerSet STORAGE_SharedPointers; /* shared string literals (see OBJECT_Literal) */
+arena *STORAGE_Scratch; /* region for temporaries */
+#else
+extern pointerSet STORAGE_ObjectPointers; /* defined in storage.c for c++ */
+extern pointerSet STORAGE_FreedPointers;
+extern pointerSet STORAGE_SharedPointers;
+extern arena *STORAGE_Scratch;
 #endif
 
 object *STORAGE_Register(object *o); /* register an object into our list */
@@ -31,6 +56,15 @@ void STORAGE_FreeAll(); /* should be run at end of program to free all unfreed m
 void STORAGE_Init(); /* initialise pointer lists */
 int STORAGE_Find(object *o); /* find an object in storage, return 1 if it exists, 0 if otherwise */
 int STORAGE_FindFreed(object *o); /* same as STORAGE_Find, searches through freed pointer list */
+int STORAGE_FindShared(object *o); /* same as STORAGE_Find, searches through shared string literals */
+void STORAGE_Discard(object *o); /* free a value that is no longer used, unless it is registered, shared or scratch */
+
+void STORAGE_SetInit(pointerSet *set, int cap); /* create an empty set with cap slots */
+unsigned int STORAGE_Hash(object *o); /* hash a pointer */
+int STORAGE_SetSlot(pointerSet *set, object *o); /* slot holding o, or the empty slot where it would go */
+void STORAGE_SetAdd(pointerSet *set, object *o); /* add a pointer to a set */
+int STORAGE_SetHas(pointerSet *set, object *o); /* return 1 if a pointer is in a set, 0 if otherwise */
+void STORAGE_SetRemove(pointerSet *set, object *o); /* remove a pointer from a set */
 
 #ifdef __cplusplus /* c++ check */
 }
@@ -0,0 +1,43 @@
+/* string functions written in c. they are assigned to their names
+when the program starts, like true, false and null, so they can be
+called without including anything:
+		stralloc(bufsz: int) -> int		address of a new string of bufsz spaces
+		strlen(strbuf: int) -> int		length of the string at an address
+		strcpy(src: int, dst: str) -> int	copy dst into the start of the string at src
+		strfill(src: int, ch: str) -> int	set every char of the string at src to the
+						first char of ch
+		strfmt(src: int, asrc: str) -> int	address of a new string with the last '%'
+							of the string at src replaced by asrc
+		strfind(s: str, sub: str) -> int	index of the first sub in s, or -1
+		substr(s: str, start: int, len: int) -> str	up to len chars of s from start
+		strsplit(s: str, sep: str, idx: int) -> str	piece idx of s split at each sep
+functions that take an address return it (or a new one) so calls
+can be used the same way as the ones that used to be written in
+stdlib/string.adm, which now only has the ss* versions that take
+and return strings. */
+#include "object.h" /* objects */
+
+#ifndef STRLIB_H
+#define STRLIB_H
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+void STRLIB_Init(); /* assign the string functions to their names */
+object *STRLIB_Deref(object *adr, const char **err); /* string at an address, or NULL with err set */
+int STRLIB_IndexOf(const char *s, int len, const char *sub, int sublen, int from); /* index of sub in s at or after from, or -1 */
+object *STRLIB_Alloc(object **args, const char **err); /* stralloc */
+object *STRLIB_Len(object **args, const char **err); /* strlen */
+object *STRLIB_Cpy(object **args, const char **err); /* strcpy */
+object *STRLIB_Fill(object **args, const char **err); /* strfill */
+object *STRLIB_Fmt(object **args, const char **err); /* strfmt */
+object *STRLIB_Find(object **args, const char **err); /* strfind */
+object *STRLIB_Sub(object **args, const char **err); /* substr */
+object *STRLIB_Split(object **args, const char **err); /* strsplit */
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
+
+#endif /* STRLIB_H */
@@ -37,15 +37,42 @@ extern "C" {
 #define TOKEN_GT			27/* '>'			*/
 #define TOKEN_EOF			100 /* end of the file */
 
+/* ids of keywords (TOKEN_KWD) and type names (TOKEN_VAR_WORD),
+set by the lexer so that they can be compared without strcmp */
+#define TOKEN_ID_NONE		0 /* not a keyword */
+#define TOKEN_ID_RETURN		1 /* 'return'		*/
+#define TOKEN_ID_PUTS		2 /* 'puts'			*/
+#define TOKEN_ID_IF			3 /* 'if'			*/
+#define TOKEN_ID_FOR		4 /* 'for'			*/
+#define TOKEN_ID_WHILE		5 /* 'while'		*/
+#define TOKEN_ID_TO			6 /* 'to'			*/
+#define TOKEN_ID_FN			7 /* 'fn'			*/
+#define TOKEN_ID_SIZEOF		8 /* 'sizeof'		*/
+#define TOKEN_ID_END		9 /* 'end'			*/
+#define TOKEN_ID_STRUCT		10/* 'struct'		*/
+#define TOKEN_ID_STDIN		11/* 'stdin'		*/
+#define TOKEN_ID_INCLUDE	12/* 'include'		*/
+#define TOKEN_ID_NEW		13/* 'new'			*/
+#define TOKEN_ID_STEP		14/* 'step'			*/
+#define TOKEN_ID_INT		15/* 'int' (first type name) */
+#define TOKEN_ID_FLOAT		16/* 'float'		*/
+#define TOKEN_ID_CHAR		17/* 'char'			*/
+#define TOKEN_ID_STR		18/* 'str'			*/
+#define TOKEN_ID_INST		19/* 'inst'			*/
+#define TOKEN_ID_VEC		20/* 'vec'			*/
+#define TOKEN_ID_MAP		21/* 'map'			*/
+
 /* token struct for storing token information */
 typedef struct _ADAMITE_Lib_Token {
 	int type; /* token type, can be any of the types specified above */
+	int id; /* keyword or type name id, TOKEN_ID_NONE for other tokens */
 	const char *value; /* usually reliant on the type */
 	int lineno; /* line number for error tracking */
 	int colno; /* column number for error tracking */
 } token;
 
 #define TOKEN_Matches(tok, ty, val) (tok->type == ty && (!strcmp(tok->value, val))) /* see if token's type and value match */
+#define TOKEN_Is(tok, ty, i) (tok->type == ty && tok->id == i) /* see if token's type and id match */
 
 token *TOKEN_NewToken(int type, const char *value, int lineno, int colno); /* allocate a new token in the heap */
 void TOKEN_FreeToken(token *t); /* free a token from memory */
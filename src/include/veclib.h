@@ -0,0 +1,34 @@
+/* vector functions written in c. they are assigned to their names
+when the program starts, like the string functions (see strlib.h):
+		vecnew() -> vec				new empty vector
+		vecpush(v: vec, x) -> int		add x to the end, returns the new length
+		vecpop(v: vec) -> x			remove the last value and return it
+		vecget(v: vec, idx: int) -> x		value at idx (same as v[idx])
+		vecset(v: vec, idx: int, x) -> x	set the value at idx (same as v[idx] = x)
+		veclen(v: vec) -> int			number of values
+		vecreserve(v: vec, cap: int) -> int	make room for cap values, returns the room
+values can be of any type, but every value of a vector has the
+type of the first one pushed into it. */
+#include "object.h" /* objects */
+
+#ifndef VECLIB_H
+#define VECLIB_H
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+void VECLIB_Init(); /* assign the vector functions to their names */
+object *VECLIB_New(object **args, const char **err); /* vecnew */
+object *VECLIB_Push(object **args, const char **err); /* vecpush */
+object *VECLIB_Pop(object **args, const char **err); /* vecpop */
+object *VECLIB_Get(object **args, const char **err); /* vecget */
+object *VECLIB_Set(object **args, const char **err); /* vecset */
+object *VECLIB_Len(object **args, const char **err); /* veclen */
+object *VECLIB_Reserve(object **args, const char **err); /* vecreserve */
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
+
+#endif /* VECLIB_H */
@@ -0,0 +1,23 @@
+/* stack based virtual machine that runs the
+instructions made by the compiler. */
+#include "compiler.h" /* chunks */
+#include "interpreter.h" /* interpreter state */
+#include "object.h" /* objects */
+
+#ifndef VM_H
+#define VM_H
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+object *VM_Execute(interpreter *i, chunk *c); /* run a chunk, returns the value left by it or NULL on error */
+void VM_Push(interpreter *i, object *o); /* push a value onto the stack */
+object *VM_Pop(interpreter *i); /* pop a value from the stack */
+void VM_Unwind(interpreter *i, int base); /* free values on the stack above base after an error */
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
+
+#endif /* VM_H */
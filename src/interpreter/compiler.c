@@ -0,0 +1,279 @@
+/* see compiler.h for documentation */
+#include "compiler.h" /* our header */
+#include "node.h" /* nodes */
+#include "token.h" /* tokens */
+#include "memory.h" /* memory management */
+
+#include <stdlib.h> /* malloc/realloc/free */
+#include <stdio.h> /* printf */
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+chunk *COMPILER_Compile(node *n) {
+	/* allocate new chunk */
+	chunk *c = MEMORY_Malloc(chunk);
+	/* failed allocation */
+	if (c == NULL)
+		return NULL;
+	/* assign values */
+	c->code = (int*)malloc(sizeof(int) * 64); /* instructions */
+	c->nodes = (node**)malloc(sizeof(node*) * 16); /* nodes */
+	c->n_of_code = 0; /* number of ints in code */
+	c->code_cap = 64; /* capacity of code */
+	c->n_of_nodes = 0; /* number of nodes */
+	c->nodes_cap = 16; /* capacity of nodes */
+	/* compile the node */
+	COMPILER_CompileNode(c, n);
+	/* return the value of the node */
+	COMPILER_Emit(c, OP_RETURN);
+	/* return chunk */
+	return c;
+}
+
+void COMPILER_FreeChunk(chunk *c) {
+	/* nodes belong to the parser, so only the lists are freed */
+	free(c->code);
+	free(c->nodes);
+	/* free the chunk */
+	MEMORY_Free(c);
+}
+
+int COMPILER_Emit(chunk *c, int x) {
+	/* check the capacity */
+	if (c->n_of_code >= c->code_cap) {
+		/* realloc list */
+		c->code = (int*)realloc(c->code, sizeof(int) * c->code_cap * 2);
+		/* update cap */
+		c->code_cap *= 2;
+	}
+	/* add the int */
+	c->code[c->n_of_code] = x;
+	/* return position */
+	return c->n_of_code++;
+}
+
+int COMPILER_AddNode(chunk *c, node *n) {
+	/* check the capacity */
+	if (c->n_of_nodes >= c->nodes_cap) {
+		/* realloc list */
+		c->nodes = (node**)realloc(c->nodes, sizeof(node*) * c->nodes_cap * 2);
+		/* update cap */
+		c->nodes_cap *= 2;
+	}
+	/* add the node */
+	c->nodes[c->n_of_nodes] = n;
+	/* return index */
+	return c->n_of_nodes++;
+}
+
+void COMPILER_CompileNode(chunk *c, node *n) {
+	/* positions of jumps that are filled in later */
+	int jump, loop;
+
+	switch (n->type) {
+		/* integer literal, decoded by the parser */
+		case NODE_INT:
+			COMPILER_Emit(c, OP_INT);
+			COMPILER_Emit(c, n->c);
+			break;
+		/* string literal */
+		case NODE_STRING:
+			COMPILER_Emit(c, OP_STRING);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			break;
+		/* variable access */
+		case NODE_VARAC:
+			COMPILER_Emit(c, OP_LOAD);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			break;
+		/* variable declaration */
+		case NODE_VARDEC:
+			COMPILER_CompileNode(c, n->children[0]); /* value */
+			COMPILER_Emit(c, OP_DECLARE);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			break;
+		/* assignment to an existing variable */
+		case NODE_ASSIGN:
+			COMPILER_CompileNode(c, n->children[0]); /* value */
+			COMPILER_Emit(c, OP_ASSIGN);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			break;
+		/* binary operation */
+		case NODE_BINOP:
+			COMPILER_CompileNode(c, n->children[0]); /* left */
+			COMPILER_CompileNode(c, n->children[1]); /* right */
+			COMPILER_Emit(c, OP_BINARY);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			break;
+		/* unary operation */
+		case NODE_UNOP:
+			COMPILER_CompileNode(c, n->children[0]);
+			COMPILER_Emit(c, OP_NEGATE);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			break;
+		/* multiple statements; the value of the last one is kept */
+		case NODE_STATEMENTS:
+			/* nothing to run */
+			if (n->n_of_children == 0) {
+				COMPILER_Emit(c, OP_VISIT);
+				COMPILER_Emit(c, COMPILER_AddNode(c, n));
+				break;
+			}
+			for (int i = 0; i < n->n_of_children; i++) {
+				/* discard the previous value */
+				if (i > 0) COMPILER_Emit(c, OP_POP);
+				COMPILER_CompileNode(c, n->children[i]);
+			}
+			break;
+		/* print statement */
+		case NODE_PRINT:
+			COMPILER_CompileNode(c, n->children[0]);
+			COMPILER_Emit(c, OP_PRINT);
+			break;
+		/* size of a value; size of a type is left to the tree walker */
+		case NODE_SIZEOF:
+			if (n->b) {
+				COMPILER_Emit(c, OP_VISIT);
+				COMPILER_Emit(c, COMPILER_AddNode(c, n));
+				break;
+			}
+			COMPILER_CompileNode(c, n->children[0]);
+			COMPILER_Emit(c, OP_SIZEOF);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			break;
+		/* function call */
+		case NODE_CALL:
+			/* push arguments */
+			for (int i = 0; i < n->n_of_children; i++)
+				COMPILER_CompileNode(c, n->children[i]);
+			COMPILER_Emit(c, OP_CALL);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			COMPILER_Emit(c, n->n_of_children);
+			break;
+		/* address of a value */
+		case NODE_ADDRESS:
+			COMPILER_CompileNode(c, n->children[0]);
+			COMPILER_Emit(c, OP_ADDRESS);
+			break;
+		/* value at an address */
+		case NODE_VALUE:
+			COMPILER_CompileNode(c, n->children[0]);
+			COMPILER_Emit(c, OP_VALUE);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			break;
+		/* get item at index */
+		case NODE_GETITEM:
+			COMPILER_CompileNode(c, n->children[0]); /* index */
+			COMPILER_Emit(c, OP_GETITEM);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			break;
+		/* set item at index */
+		case NODE_SETITEM:
+			COMPILER_CompileNode(c, n->children[0]); /* index */
+			COMPILER_CompileNode(c, n->children[1]); /* value */
+			COMPILER_Emit(c, OP_SETITEM);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			break;
+		/* if statement; always has the value 1 */
+		case NODE_IFNODE:
+			jump = COMPILER_CompileCondition(c, n->children[0]); /* comparison */
+			COMPILER_CompileNode(c, n->children[1]); /* statements */
+			COMPILER_Emit(c, OP_POP);
+			c->code[jump] = c->n_of_code; /* skip to here if false */
+			COMPILER_Emit(c, OP_INT);
+			COMPILER_Emit(c, 1);
+			break;
+		/* while loop; always has the value 1 */
+		case NODE_WHILE:
+			loop = c->n_of_code; /* start of loop */
+			jump = COMPILER_CompileCondition(c, n->children[0]); /* comparison */
+			COMPILER_CompileNode(c, n->children[1]); /* statements */
+			COMPILER_Emit(c, OP_POP);
+			COMPILER_Emit(c, OP_JUMP);
+			COMPILER_Emit(c, loop);
+			c->code[jump] = c->n_of_code; /* exit loop to here */
+			COMPILER_Emit(c, OP_INT);
+			COMPILER_Emit(c, 1);
+			break;
+		/* for loop; has the value of the counter */
+		case NODE_FORLOOP:
+			COMPILER_CompileNode(c, n->children[1]); /* start */
+			COMPILER_CompileNode(c, n->children[2]); /* end */
+			/* step, 1 if it isn't given */
+			if (n->n_of_children > 3)
+				COMPILER_CompileNode(c, n->children[3]);
+			else {
+				COMPILER_Emit(c, OP_INT);
+				COMPILER_Emit(c, 1);
+			}
+			COMPILER_Emit(c, OP_FOR_INIT);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			loop = c->n_of_code; /* start of loop */
+			COMPILER_Emit(c, OP_FOR_NEXT);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			jump = COMPILER_Emit(c, 0);
+			COMPILER_CompileNode(c, n->children[0]); /* statements */
+			COMPILER_Emit(c, OP_POP);
+			COMPILER_Emit(c, OP_JUMP);
+			COMPILER_Emit(c, loop);
+			c->code[jump] = c->n_of_code; /* exit loop to here */
+			COMPILER_Emit(c, OP_FOR_END);
+			break;
+		/* declarations and other rarely run nodes are left to the tree walker */
+		default:
+			COMPILER_Emit(c, OP_VISIT);
+			COMPILER_Emit(c, COMPILER_AddNode(c, n));
+			break;
+	}
+}
+
+int COMPILER_CompileCondition(chunk *c, node *n) {
+	/* a comparison jumps on its two values, without making an int */
+	if (n->type == NODE_BINOP && (n->tokens[0]->type == TOKEN_EE || n->tokens[0]->type == TOKEN_NE
+		|| n->tokens[0]->type == TOKEN_LT || n->tokens[0]->type == TOKEN_GT)) {
+		COMPILER_CompileNode(c, n->children[0]); /* left */
+		COMPILER_CompileNode(c, n->children[1]); /* right */
+		COMPILER_Emit(c, OP_JUMP_IF_NOT);
+		COMPILER_Emit(c, COMPILER_AddNode(c, n));
+		return COMPILER_Emit(c, 0);
+	}
+	/* any other value */
+	COMPILER_CompileNode(c, n);
+	COMPILER_Emit(c, OP_JUMP_IF_FALSE);
+	return COMPILER_Emit(c, 0);
+}
+
+void COMPILER_PrintChunk(chunk *c) {
+	/* names of opcodes */
+	const char *names[] = {"INT", "STRING", "LOAD", "DECLARE", "BINARY", "NEGATE", "PRINT", "POP", "JUMP", "JUMP_IF_FALSE",
+		"CALL", "GETITEM", "SETITEM", "ADDRESS", "VALUE", "SIZEOF", "FOR_INIT", "FOR_NEXT", "FOR_END", "VISIT", "RETURN",
+		"ASSIGN", "JUMP_IF_NOT"};
+	/* loop through instructions */
+	int pc = 0;
+	while (pc < c->n_of_code) {
+		int op = c->code[pc];
+		printf("%4d %s", pc++, names[op]);
+		/* operands */
+		switch (op) {
+			case OP_INT: case OP_JUMP: case OP_JUMP_IF_FALSE:
+				printf(" %d", c->code[pc++]);
+				break;
+			case OP_CALL: case OP_FOR_NEXT: case OP_JUMP_IF_NOT:
+				printf(" <node %d> %d", c->code[pc], c->code[pc+1]);
+				pc += 2;
+				break;
+			case OP_PRINT: case OP_POP: case OP_ADDRESS: case OP_FOR_END: case OP_RETURN:
+				break;
+			default:
+				printf(" <node %d>", c->code[pc++]);
+				break;
+		}
+		printf("\n");
+	}
+}
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
@@ -9,8 +9,11 @@
 #include "token.h" /* tokens */
 #include "names.h" /* name storage */
 #include "run.h" /* run a file */
+#include "compiler.h" /* bytecode compiler */
+#include "vm.h" /* bytecode vm */
+#include "gc.h" /* garbage collector */
 
-#include <stdlib.h> /* atoi */
+#include <stdlib.h> /* malloc/free */
 #include <string.h> /* strcmp */
 #include <stdio.h> /* printf */
 
@@ -25,12 +28,28 @@ interpreter *INTERPRETER_NewInterpreter() {
 	if (i == NULL)
 		return NULL;
 	i->e = NULL; /* error */
+	/* vm stack */
+	i->stack = (object**)malloc(sizeof(object*) * 64);
+	i->sp = 0;
+	i->stack_cap = 64;
+	/* frames of locals */
+	i->frame = (object**)malloc(sizeof(object*) * 64);
+	i->fp = 0;
+	i->frame_sz = 0;
+	i->frame_cap = 64;
+	/* values on the stack and in frames are roots */
+	GC_AddInterpreter(i);
 	return i; /* return */
 }
 
 void INTERPRETER_FreeInterpreter(interpreter *i) {
 	/* free error */
 	if (i->e != NULL) MEMORY_Free(i->e);
+	/* free vm stack */
+	GC_RemoveInterpreter(i);
+	free(i->stack);
+	/* free frames */
+	free(i->frame);
 	/* free interp */
 	MEMORY_Free(i);
 }
@@ -106,6 +125,9 @@ object *INTERPRETER_Visit(interpreter *i, node *n) {
 	else if (n->type == NODE_WHILE)
 		/* while loop */
 		return INTERPRETER_VisitWhile(i, n);
+	else if (n->type == NODE_ASSIGN)
+		/* assign to an existing variable */
+		return INTERPRETER_VisitAssign(i, n);
 
 	else /* no method found */
 		return NULL;
@@ -114,8 +136,8 @@ object *INTERPRETER_Visit(interpreter *i, node *n) {
 object *INTERPRETER_VisitInclude(interpreter *i, node *n) {
 	/* get filename */
 	const char *fname = n->tokens[0]->value;
-	/* run file */
-	int code = run(fname);
+	/* run file, unless it has already been run */
+	int code = include(fname);
 	/* code that is not 0 means error */
 	if (code != 0) {
 		/* create new error */
@@ -136,7 +158,7 @@ object *INTERPRETER_VisitNew(interpreter *i, node *n) {
 			return NULL; /* exit */
 		}
 		/* type is not integer */
-		if (o->type != OBJECT_INT) {
+		if (OBJECT_TypeOf(o) != OBJECT_INT) {
 			/* create error */
 			i->e = ERROR_RuntimeError("Array size must be integer", n->children[0]->lineno, n->children[1]->colno);
 			/* free stuff */
@@ -144,35 +166,25 @@ object *INTERPRETER_VisitNew(interpreter *i, node *n) {
 			return NULL; /* exit */
 		}
 		/* get value and free object */
-		int arr_sz = *(int*)o->value;
+		int arr_sz = OBJECT_IntValue(o);
 		if (!STORAGE_Find(o)) OBJECT_FreeObject(o);
-		/* get type */
-		uint8_t obj_type = 255;
-		char *v_type = (char*)n->tokens[0]->value;
-		/* int */
-		if (!strcmp(v_type, "int")) obj_type = OBJECT_INT;
-		/* char */
-		if (!strcmp(v_type, "char")) obj_type = OBJECT_CHAR;
-		/* instance */
-		if (!strcmp(v_type, "inst")) obj_type = OBJECT_INSTANCE;
-		/* string */
-		if (!strcmp(v_type, "str")) obj_type = OBJECT_STRING;
-		/* create array */
-		object *a = OBJECT_NewArray(obj_type, arr_sz);
+		/* create array of the type resolved by the parser */
+		object *a = OBJECT_NewArray(n->vtype, arr_sz);
 		/* register object */
 		a = STORAGE_Register(a);
 		/* return pointer */
 		return OBJECT_NewInt((int)a);
 	}
 	/* get type */
-	char *v_type = (char*)n->tokens[0]->value;
 	object *o = NULL;
-	/* create an int */
-	if (!strcmp(v_type, "int")) o = OBJECT_NewInt(0);
-	/* create a char */
-	if (!strcmp(v_type, "char")) o = OBJECT_NewChar(0);
-	/* create a string */
-	if (!strcmp(v_type, "str")) o = OBJECT_NewString("");
+	switch (n->vtype) {
+		/* create an int */
+		case OBJECT_INT: o = OBJECT_NewInt(0); break;
+		/* create a char */
+		case OBJECT_CHAR: o = OBJECT_NewChar(0); break;
+		/* create a string */
+		case OBJECT_STRING: o = OBJECT_NewString(""); break;
+	}
 	/* register object */
 	o = STORAGE_Register(o);
 	/* return object */
@@ -195,16 +207,8 @@ object *INTERPRETER_VisitStruct(interpreter *i, node *n) {
 	/* loop through tokens */
 	for (int j = 0; j < n_of_vals * 2; j += 2) {
 		/* store name and type */
-		uint8_t val_type = 255;
+		uint8_t val_type = OBJECT_TypeOfName(n->tokens[j+2]->id);
 		char *val_name = (char*)n->tokens[j+1]->value;
-		/* int */
-		if (!strcmp(n->tokens[j+2]->value, "int")) val_type = OBJECT_INT;
-		/* char */
-		if (!strcmp(n->tokens[j+2]->value, "char")) val_type = OBJECT_CHAR;
-		/* string */
-		if (!strcmp(n->tokens[j+2]->value, "str")) val_type = OBJECT_STRING;
-		/* struct instance */
-		if (!strcmp(n->tokens[j+2]->value, "inst")) val_type = OBJECT_INSTANCE;
 		/* copy name */
 		char *_val_name = (char*)malloc(strlen(val_name)+2);
 		strcpy(_val_name, val_name);
@@ -220,39 +224,21 @@ object *INTERPRETER_VisitStruct(interpreter *i, node *n) {
 }
 
 object *INTERPRETER_VisitArray(interpreter *i, node *n) {
-	/* get tokens */
-	token *var_type = n->tokens[0];
-	token *array_size = n->tokens[1];
-	int arr_sz = atoi(array_size->value);
-	/* get type */
-	uint8_t tp = 255;
-	/* int */
-	if (!strcmp((char*)var_type->value, "int")) tp = OBJECT_INT;
-	/* char */
-	if (!strcmp((char*)var_type->value, "char")) tp = OBJECT_CHAR;
-	/* str */
-	if (!strcmp((char*)var_type->value, "str")) tp = OBJECT_STRING;
-	/* struct instance */
-	if (!strcmp((char*)var_type->value, "inst")) tp = OBJECT_INSTANCE;
-	/* new array */
-	return OBJECT_NewArray(tp, arr_sz);
+	/* new array of the type and size resolved by the parser */
+	return OBJECT_NewArray(n->vtype, n->c);
 }
 
 object *INTERPRETER_VisitNumber(interpreter *i, node *n) {
-	/* int */
-	if (n->type == NODE_INT) {
-		/* get value of int */
-		int x = atoi(n->tokens[0]->value);
-		/* return new int */
-		return OBJECT_NewInt(x);
-	}
-	/* otherwise, return null */
-	return NULL;
+	/* int, decoded by the parser */
+	if (n->type == NODE_INT)
+		return OBJECT_NewInt(n->c);
+	/* float, decoded by the parser */
+	return OBJECT_NewFloat(n->f);
 }
 
 object *INTERPRETER_VisitString(interpreter *i, node *n) {
-	/* return new string object */
-	return OBJECT_NewString(n->tokens[0]->value);
+	/* return the literal's shared string object */
+	return OBJECT_Literal(n);
 }
 
 object *INTERPRETER_VisitSizeof(interpreter *i, node *n) {
@@ -261,9 +247,11 @@ object *INTERPRETER_VisitSizeof(interpreter *i, node *n) {
 	int size = 0;
 	if (n->b) {
 		/* get size of type */
-		if (!strcmp(n->tokens[0]->value, "int")) size = sizeof(int);
-		else if (!strcmp(n->tokens[0]->value, "char")) size = sizeof(char);
-		else if (!strcmp(n->tokens[0]->value, "str")) size = sizeof(char*);
+		switch (n->vtype) {
+			case OBJECT_INT: size = sizeof(int); break;
+			case OBJECT_CHAR: size = sizeof(char); break;
+			case OBJECT_STRING: size = sizeof(char*); break;
+		}
 	}
 	else {
 		/* get size of value */
@@ -275,41 +263,53 @@ object *INTERPRETER_VisitSizeof(interpreter *i, node *n) {
 			/* return */
 			return NULL;
 		}
-		/* arrays */
-		if (o->type == OBJECT_ARRAY) {
-			/* array pointer */
-			arrayObject *a = (arrayObject*)o->value;
-			/* length of array */
-			size = a->size;
-			/* int array */
-			if (a->array_type == OBJECT_INT) size *= sizeof(int);
-			/* char array */
-			else if (a->array_type == OBJECT_CHAR) size *= sizeof(char);
-		}
-		/* int */
-		else if (o->type == OBJECT_INT) size = sizeof(int);
-		/* char */
-		else if (o->type == OBJECT_CHAR) size = sizeof(char);
-		/* string */
-		else if (o->type == OBJECT_STRING) size = strlen((char*)o->value) * sizeof(char);
-		/* free stuff */
-		if (!STORAGE_Find(o)) OBJECT_FreeObject(o);
+		/* get size of value */
+		return INTERPRETER_SizeOf(i, n, o);
+	}
+	/* return new int */
+	return OBJECT_NewInt(size);
+}
+
+object *INTERPRETER_SizeOf(interpreter *i, node *n, object *o) {
+	/* final size value */
+	int size = 0;
+	/* arrays and vectors */
+	if (OBJECT_TypeOf(o) == OBJECT_ARRAY || OBJECT_TypeOf(o) == OBJECT_VECTOR) {
+		/* array pointer */
+		arrayObject *a = (arrayObject*)o->value;
+		/* length of array */
+		size = a->size;
+		/* int array */
+		if (a->array_type == OBJECT_INT) size *= sizeof(int);
+		/* char array */
+		else if (a->array_type == OBJECT_CHAR) size *= sizeof(char);
 	}
+	/* int */
+	else if (OBJECT_TypeOf(o) == OBJECT_INT) size = sizeof(int);
+	/* char */
+	else if (OBJECT_TypeOf(o) == OBJECT_CHAR) size = sizeof(char);
+	/* string */
+	else if (OBJECT_TypeOf(o) == OBJECT_STRING) size = OBJECT_StringLen(o) * sizeof(char);
+	/* free stuff */
+	if (!STORAGE_Find(o)) OBJECT_FreeObject(o);
 	/* return new int */
 	return OBJECT_NewInt(size);
 }
 
 object *INTERPRETER_VisitStatements(interpreter *i, node *n) {
 	object *o = NULL; /* default value */
+	/* temporaries of each statement are released together */
+	arenaMark mark = ARENA_Mark(STORAGE_Scratch);
 
 	/* loop through statement nodes */
 	for (int j = 0; j < n->n_of_children; j++) {
-		/* free previous object if not null and not registered */
+		/* done with the previous statement */
 		if (o != NULL) {
-			if (!STORAGE_Find(o)) {
-				OBJECT_FreeObject(o); /* free object */
-			}
+			STORAGE_Discard(o);
+			ARENA_Release(STORAGE_Scratch, mark);
 		}
+		/* collect garbage between statements */
+		GC_Check();
 		/* visit child */
 		o = INTERPRETER_Visit(i, n->children[j]);
 	
@@ -351,39 +351,156 @@ object *INTERPRETER_VisitFuncDef(interpreter *i, node *n) {
 	int n_of_args = (n->n_of_toks - 2) / 2; /* number of arguments */
 	char **arg_names = (char**)malloc(sizeof(char*) * n_of_args); /* argument names */
 	uint8_t *arg_types = (uint8_t*)malloc(sizeof(uint8_t) * n_of_args); /* argument types */
-	uint8_t ret_type = 255; /* default return type */
-	char *rt = (char*)n->tokens[n->n_of_toks-1]->value;
-	if (!strcmp(rt, "int")) ret_type = OBJECT_INT; /* int */
-	if (!strcmp(rt, "char")) ret_type = OBJECT_CHAR; /* char */
-	if (!strcmp(rt, "str")) ret_type = OBJECT_STRING; /* string */
-	if (!strcmp(rt, "inst")) ret_type = OBJECT_INSTANCE; /* struct instance */
+	uint8_t ret_type = n->vtype; /* return type, resolved by the parser */
 	/* loop through tokens and copy argument names and types */
 	for (int i = 0; i < n_of_args * 2; i += 2) {
-		uint8_t arg_type = 255; /* argument type */
-		if (!strcmp(n->tokens[i + 2]->value, "int")) arg_type = OBJECT_INT;
-		if (!strcmp(n->tokens[i + 2]->value, "char")) arg_type = OBJECT_CHAR;
-		if (!strcmp(n->tokens[i + 2]->value, "str")) arg_type = OBJECT_STRING;
-		if (!strcmp(n->tokens[i + 2]->value, "inst")) arg_type = OBJECT_INSTANCE;
-		arg_types[i / 2] = arg_type;
+		arg_types[i / 2] = OBJECT_TypeOfName(n->tokens[i + 2]->id); /* argument type */
 		/* copy argument name */
-		char *arg_name = (char*)malloc(strlen((char*)n->tokens[1 + i]->value));
+		char *arg_name = (char*)malloc(strlen((char*)n->tokens[1 + i]->value) + 1);
 		strcpy(arg_name, n->tokens[1 + i]->value);
 		/* assign argument name */
-		arg_names[i / 2] = /*(char*)n->tokens[1 + i]->value*/arg_name;
+		arg_names[i / 2] = arg_name;
 	}
 	/* body of function */
-	node *body_node = NODE_CopyNode(n->children[0]);
+	arena *body_arena = ARENA_NewArena(NODE_ARENA_SIZE);
+	node *body_node = NODE_CopyNode(body_arena, n->children[0]);
+	/* arguments take the first slots, then every name declared in the body */
+	scope s;
+	s.names = (char**)malloc(sizeof(char*) * 16);
+	s.n_of_names = 0;
+	s.names_cap = 16;
+	for (int k = 0; k < n_of_args; k++)
+		INTERPRETER_AddLocal(&s, arg_names[k]);
+	INTERPRETER_CollectLocals(&s, body_node);
+	INTERPRETER_ResolveLocals(&s, body_node);
 	/* create a new function object */
-	object *f = STORAGE_Register(OBJECT_NewFunction(func_name, ret_type, arg_names, arg_types, n_of_args, body_node));
+	object *f = STORAGE_Register(OBJECT_NewFunction(func_name, ret_type, arg_names, arg_types, n_of_args, body_node, body_arena));
+	((function*)f->value)->n_of_locals = s.n_of_names;
+	/* names belong to the body and arguments */
+	free(s.names);
 	/* assign the name to the function */
 	NAMES_Assign(func_name, f);
 	/* return an int with the location of the function */
 	return OBJECT_NewInt((int)f);
 }
 
+int INTERPRETER_FindLocal(scope *s, char *name) {
+	/* functions have few locals, so search the list */
+	for (int k = 0; k < s->n_of_names; k++)
+		if (!strcmp(s->names[k], name)) return k;
+	/* not local */
+	return -1;
+}
+
+int INTERPRETER_AddLocal(scope *s, char *name) {
+	/* already has a slot */
+	int slot = INTERPRETER_FindLocal(s, name);
+	if (slot != -1) return slot;
+	/* check the capacity */
+	if (s->n_of_names >= s->names_cap) {
+		/* realloc list */
+		s->names = (char**)realloc(s->names, sizeof(char*) * s->names_cap * 2);
+		/* update cap */
+		s->names_cap *= 2;
+	}
+	/* add the name */
+	s->names[s->n_of_names] = name;
+	return s->n_of_names++;
+}
+
+void INTERPRETER_CollectLocals(scope *s, node *n) {
+	/* functions defined inside the body have their own frames */
+	if (n->type == NODE_FUNCDEF) return;
+	/* variables and loop counters declared in the body are local */
+	if (n->type == NODE_VARDEC || n->type == NODE_FORLOOP)
+		INTERPRETER_AddLocal(s, (char*)n->tokens[0]->value);
+	/* collect from children */
+	for (int k = 0; k < n->n_of_children; k++)
+		INTERPRETER_CollectLocals(s, n->children[k]);
+}
+
+void INTERPRETER_ResolveLocals(scope *s, node *n) {
+	/* functions defined inside the body are resolved when they are defined */
+	if (n->type == NODE_FUNCDEF) return;
+	/* nodes that name a variable */
+	if (n->type == NODE_VARDEC || n->type == NODE_FORLOOP || n->type == NODE_VARAC
+		|| n->type == NODE_GETITEM || n->type == NODE_SETITEM || n->type == NODE_ASSIGN)
+		n->d = INTERPRETER_FindLocal(s, (char*)n->tokens[0]->value) + 1;
+	/* resolve children */
+	for (int k = 0; k < n->n_of_children; k++)
+		INTERPRETER_ResolveLocals(s, n->children[k]);
+}
+
+object *INTERPRETER_GetName(interpreter *i, node *n) {
+	/* local that has been assigned */
+	if (n->d > 0 && i->frame[i->fp + n->d - 1] != NULL)
+		return i->frame[i->fp + n->d - 1];
+	/* global, or a local read before it is declared */
+	nameEntry *e = NAMES_Find((char*)n->tokens[0]->value, &n->slot);
+	return e != NULL ? e->value : NULL;
+}
+
+void INTERPRETER_SetName(interpreter *i, node *n, object *o) {
+	/* local */
+	if (n->d > 0)
+		i->frame[i->fp + n->d - 1] = o;
+	/* global */
+	else {
+		nameEntry *e = NAMES_Find((char*)n->tokens[0]->value, &n->slot);
+		/* new global */
+		if (e == NULL) NAMES_Assign((char*)n->tokens[0]->value, o);
+		else e->value = o;
+	}
+}
+
 object *INTERPRETER_VisitCall(interpreter *i, node *n) {
 	/* get the function */
-	object *fobj = NAMES_Get((char*)n->tokens[0]->value);
+	object *fobj = INTERPRETER_GetCallable(i, n);
+	/* error */
+	if (fobj == NULL)
+		return NULL;
+	/* struct */
+	if (OBJECT_TypeOf(fobj) == OBJECT_STRUCT)
+		/* create instance */
+		return INTERPRETER_CallFunction(i, n, fobj, NULL);
+	/* otherwise, function */
+	function *f = (function*)fobj->value;
+	/* arguments are pushed onto the stack, where they are roots until the call ends */
+	int base = i->sp;
+	/* visit each object */
+	for (int k = 0; k < f->n_of_args; k++) {
+		/* visit an object */
+		object *o = INTERPRETER_Visit(i, n->children[k]);
+		/* error */
+		if (o == NULL || i->e != NULL) {
+			VM_Unwind(i, base);
+			return NULL;
+		}
+		/* check type */
+		if (!INTERPRETER_CheckArgument(i, n, f, k, o)) {
+			/* free object */
+			if (!STORAGE_Find(o)) OBJECT_FreeObject(o);
+			VM_Unwind(i, base);
+			/* return */
+			return NULL;
+		}
+		/* locals hold registered values; ints and chars aren't allocated, so they stay unregistered */
+		if (!OBJECT_IsImmediate(o) && !STORAGE_Find(o)) o = STORAGE_Register(o);
+		OBJECT_Disown(o); /* the argument can see it too */
+		VM_Push(i, o);
+	}
+	/* call the function; the arguments are copied into its frame before the stack can grow */
+	object *o3 = INTERPRETER_CallFunction(i, n, fobj, &i->stack[base]);
+	/* pop the arguments */
+	i->sp = base;
+	/* return result */
+	return o3;
+}
+
+object *INTERPRETER_GetCallable(interpreter *i, node *n) {
+	/* get the function */
+	nameEntry *e = NAMES_Find((char*)n->tokens[0]->value, &n->slot);
+	object *fobj = e != NULL ? e->value : NULL;
 	/* function was not found */
 	if (fobj == NULL) {
 		/* create runtime error */
@@ -392,75 +509,81 @@ object *INTERPRETER_VisitCall(interpreter *i, node *n) {
 		return NULL;
 	}
 	/* unknown call type */
-	if (fobj->type != OBJECT_FUNCTION && fobj->type != OBJECT_STRUCT) {
+	if (OBJECT_TypeOf(fobj) != OBJECT_FUNCTION && OBJECT_TypeOf(fobj) != OBJECT_STRUCT) {
 		/* create error */
 		i->e = ERROR_RuntimeError("Cannot call value", n->lineno, n->colno);
 		/* return */
 		return NULL;
 	}
-	/* struct */
-	else if (fobj->type == OBJECT_STRUCT) {
-		/* create instance */
-		object *i = OBJECT_NewInstance((structObject*)fobj->value);
-		/* failed */
-		if (i == NULL)
-			return NULL;
-		/* return instance */
-		return i;
-	}
-	/* otherwise, function */
-	function *f = (function*)fobj->value;
 	/* invalid number of arguments */
-	if (n->n_of_children != f->n_of_args) {
+	if (OBJECT_TypeOf(fobj) == OBJECT_FUNCTION && n->n_of_children != ((function*)fobj->value)->n_of_args) {
 		/* create runtime error */
 		i->e = ERROR_RuntimeError("Invalid number of arguments passed", n->lineno, n->colno);
 		/* return */
 		return NULL;
 	}
-	object **o2 = (object**)malloc(sizeof(object*) * 100);
-	/* visit each object and assign it's name */
-	for (int k = 0; k < f->n_of_args; k++) {
-		/* visit an object */
-		object *o = INTERPRETER_Visit(i, n->children[k]);
-		/* error */
-		if (o == NULL || i->e != NULL)
-			return NULL;
-		/* check type */
-		if (o->type != f->arg_types[k]) {
-			/* create runtime error */
-			i->e = ERROR_RuntimeError("Mismatched argument type", n->lineno, n->colno);
-			/* free object */
-			if (!STORAGE_Find(o)) OBJECT_FreeObject(o);
-			/* return */
-			return NULL;
-		}
-		/* register if not registered */
-		if (!STORAGE_Find(o)) o = STORAGE_Register(o);
-		o2[k] = o;
-		/* assign name */
-		NAMES_Assign(f->arg_names[k], o);
+	/* return callable object */
+	return fobj;
+}
+
+int INTERPRETER_CheckArgument(interpreter *i, node *n, function *f, int k, object *o) {
+	/* check type; builtins may take any type */
+	if (f->arg_types[k] != OBJECT_ANY && OBJECT_TypeOf(o) != f->arg_types[k]) {
+		/* create runtime error */
+		i->e = ERROR_RuntimeError("Mismatched argument type", n->lineno, n->colno);
+		/* return */
+		return 0;
+	}
+	/* valid argument */
+	return 1;
+}
+
+object *INTERPRETER_CallFunction(interpreter *i, node *n, object *fobj, object **args) {
+	/* struct */
+	if (OBJECT_TypeOf(fobj) == OBJECT_STRUCT)
+		/* create instance */
+		return OBJECT_NewInstance((structObject*)fobj->value);
+	/* otherwise, function */
+	function *f = (function*)fobj->value;
+	/* builtin; it has no frame */
+	if (f->native != NULL) {
+		const char *err = "Memory Error";
+		object *o3 = f->native(args, &err);
+		/* create runtime error */
+		if (o3 == NULL) i->e = ERROR_RuntimeError((char*)err, n->lineno, n->colno);
+		return o3;
+	}
+	/* check the capacity of the frames */
+	int fp = i->fp, frame = i->frame_sz;
+	while (frame + f->n_of_locals > i->frame_cap) {
+		/* realloc frames */
+		i->frame = (object**)realloc(i->frame, sizeof(object*) * i->frame_cap * 2);
+		/* update cap */
+		i->frame_cap *= 2;
 	}
+	/* push a frame with the arguments in the first slots */
+	for (int k = 0; k < f->n_of_locals; k++)
+		i->frame[frame + k] = k < f->n_of_args ? args[k] : NULL;
+	i->fp = frame;
+	i->frame_sz = frame + f->n_of_locals;
 	/* execute the code inside the function */
-	object *o3 = INTERPRETER_Visit(i, f->body_node);
+	object *o3 = NULL;
+	if (RUN_Mode == RUN_VM) {
+		/* compile the body the first time the function is called */
+		if (f->code == NULL)
+			f->code = COMPILER_Compile(f->body_node);
+		/* run compiled body */
+		o3 = VM_Execute(i, f->code);
+	}
+	else
+		/* walk the body */
+		o3 = INTERPRETER_Visit(i, f->body_node);
+	/* pop the frame */
+	i->fp = fp;
+	i->frame_sz = frame;
 	/* error */
-	if (o3 == NULL || i->e != NULL) {
-		/* free stuff */
-		for (int j = 0; j < f->n_of_args; j++) {
-			/* free argument */
-			if (!STORAGE_Find(o2[j])) OBJECT_FreeObject(o2[j]);
-		}
-		/* free list */
-		free(o2);
-		/* return */
+	if (o3 == NULL || i->e != NULL)
 		return NULL;
-	}
-	/* free arguments */
-	for (int j = 0; j < f->n_of_args; j++) {
-		/* free argument */
-		if (!STORAGE_Find(o2[j])) OBJECT_FreeObject(o2[j]);
-	}
-	/* free list */
-	free(o2);
 	/* return result */
 	return o3;
 }
@@ -472,10 +595,13 @@ object *INTERPRETER_VisitVarAssign(interpreter *i, node *n) {
 	if (o == NULL || i->e != NULL)
 		return NULL;
 
-	/* get variable name value */
-	char *var_name = (char*)n->tokens[0]->value;
-	/* get type value */
-	char *var_type = (char*)n->tokens[1]->value;
+	/* declare the variable */
+	return INTERPRETER_Declare(i, n, o);
+}
+
+object *INTERPRETER_Declare(interpreter *i, node *n, object *o) {
+	/* get type, resolved by the parser */
+	int var_type = n->vtype;
 	/* get array related values */
 	int is_array = n->b;
 	int array_size = n->c;
@@ -487,36 +613,21 @@ object *INTERPRETER_VisitVarAssign(interpreter *i, node *n) {
 	/* array */
 	if (is_array) {
 		_var_type = OBJECT_ARRAY; /* array */
-		/* int array */
-		if (!strcmp(var_type, "int")) {
-			_array_type = OBJECT_INT; /* int */
-		}
-		/* char array */
-		if (!strcmp(var_type, "char")) {
-			_array_type = OBJECT_CHAR; /* char */
-		}
-		/* struct instance array */
-		if (!strcmp(var_type, "inst")) {
-			_array_type = OBJECT_INSTANCE; /* struct instance */
+		/* int, char and struct instance arrays */
+		if (var_type == OBJECT_INT || var_type == OBJECT_CHAR || var_type == OBJECT_INSTANCE) {
+			_array_type = var_type;
 		}
 	}
-	/* int */
-	else if (!strcmp(var_type, "int")) {
-		_var_type = OBJECT_INT; /* int */
-	}
-	/* str */
-	else if (!strcmp(var_type, "str")) {
-		_var_type = OBJECT_STRING; /* str */
-	}
-	/* instance */
-	else if (!strcmp(var_type, "inst")) {
-		_var_type = OBJECT_INSTANCE; /* instance */
+	/* int, str, instance, vector or map */
+	else if (var_type == OBJECT_INT || var_type == OBJECT_STRING || var_type == OBJECT_INSTANCE
+		|| var_type == OBJECT_VECTOR || var_type == OBJECT_MAP) {
+		_var_type = var_type;
 	}
 	/* char */
-	else if (!strcmp(var_type, "char")) {
+	else if (var_type == OBJECT_CHAR) {
 		_var_type = OBJECT_CHAR; /* char */
 		/* expects string literal */
-		if (o->type != OBJECT_STRING && o->type != OBJECT_INT) {
+		if (OBJECT_TypeOf(o) != OBJECT_STRING && OBJECT_TypeOf(o) != OBJECT_INT) {
 			/* create runtime error */
 			i->e = ERROR_RuntimeError("Mismatched Types", n->lineno, n->colno);
 			/* free an object if it isn't in storage */
@@ -524,16 +635,16 @@ object *INTERPRETER_VisitVarAssign(interpreter *i, node *n) {
 			/* return */
 			return NULL;
 		}
-		if (o->type == OBJECT_STRING) {
+		if (OBJECT_TypeOf(o) == OBJECT_STRING) {
 			/* get first char from string */
-			object *o2 = OBJECT_NewChar(((char*)o->value)[0]);
+			object *o2 = OBJECT_NewChar(OBJECT_StringChars(o)[0]);
 			/* free original object */
 			if (!STORAGE_Find(o)) OBJECT_FreeObject(o);
 			/* assign new object */
 			o = o2;
 		} else {
 			/* new char from int value */
-			object *o2 = OBJECT_NewChar((char)*(int*)o->value);
+			object *o2 = OBJECT_NewChar((char)OBJECT_IntValue(o));
 			/* free original object */
 			if (!STORAGE_Find(o)) OBJECT_FreeObject(o);
 			/* assign new object */
@@ -542,7 +653,7 @@ object *INTERPRETER_VisitVarAssign(interpreter *i, node *n) {
 	}
 
 	/* object type not same as var type */
-	if (_var_type != o->type && !is_array) {
+	if (_var_type != OBJECT_TypeOf(o) && !is_array) {
 		/* create runtime error */
 		i->e = ERROR_RuntimeError("Mismatched Types", n->lineno, n->colno);
 		/* free an object if it isn't in storage */
@@ -553,7 +664,7 @@ object *INTERPRETER_VisitVarAssign(interpreter *i, node *n) {
 	/* handling of arrays */
 	else if (is_array) {
 		/* compare array type */
-		if (_var_type == o->type) {
+		if (_var_type == OBJECT_TypeOf(o)) {
 			/* mismatched types */
 			if (((arrayObject*)o->value)->array_type != _array_type) {
 				/* create runtime error */
@@ -565,17 +676,15 @@ object *INTERPRETER_VisitVarAssign(interpreter *i, node *n) {
 			}
 		}
 		/* char array string thing */
-		else if (o->type == OBJECT_STRING && _array_type == OBJECT_CHAR) {
+		else if (OBJECT_TypeOf(o) == OBJECT_STRING && _array_type == OBJECT_CHAR) {
 			/* create a new array object */
 			object *o2 = OBJECT_NewArray(OBJECT_CHAR, array_size);
 			/* loop through string */
-			for (int i = 0; i < strlen((char*)o->value); i++) {
+			for (int i = 0; i < OBJECT_StringLen(o); i++) {
 				/* break if we've reached limit of array size */
 				if (i == array_size) break;
 				/* add the char */
-				object *c = OBJECT_NewChar(((char*)o->value)[i]);
-				if (!STORAGE_Find(c)) c = STORAGE_Register(c);
-				((arrayObject*)o2->value)->values[i] = c;
+				((arrayObject*)o2->value)->chars[i] = OBJECT_StringChars(o)[i];
 			}
 			/* free if not registered */
 			if (!STORAGE_Find(o)) OBJECT_FreeObject(o);
@@ -592,19 +701,82 @@ object *INTERPRETER_VisitVarAssign(interpreter *i, node *n) {
 		}
 	}
 
-	/* if an object is not registered, register it */
-	if (!STORAGE_Find(o)) o = STORAGE_Register(o);
+	/* if an object is not registered, register it; a new string is owned by the variable */
+	if (!STORAGE_Find(o)) {
+		o = STORAGE_Register(o);
+		if (OBJECT_TypeOf(o) == OBJECT_STRING) o->flags |= OBJECT_OWNED;
+	}
+	/* an owned string given to another variable is owned by neither */
+	else if (OBJECT_IsOwned(o) && INTERPRETER_GetName(i, n) != o)
+		OBJECT_Disown(o);
 
 	/* assign the name to the value */
-	NAMES_Assign(var_name, o);
+	INTERPRETER_SetName(i, n, o);
+
+	/* return object */
+	return o;
+}
+
+object *INTERPRETER_VisitAssign(interpreter *i, node *n) {
+	/* get the object for the value */
+	object *o = INTERPRETER_Visit(i, n->children[0]);
+	/* error or failed allocation */
+	if (o == NULL || i->e != NULL)
+		return NULL;
+
+	/* assign the variable */
+	return INTERPRETER_Assign(i, n, o);
+}
+
+object *INTERPRETER_Assign(interpreter *i, node *n, object *o) {
+	/* current value, from the frame or the names list */
+	object *old = INTERPRETER_GetName(i, n);
+	/* undefined object */
+	if (old == NULL) {
+		/* create runtime error */
+		i->e = ERROR_RuntimeError("Variable not defined", n->lineno, n->colno);
+		/* free the value */
+		STORAGE_Discard(o);
+		return NULL; /* exit */
+	}
+	/* a char can be given the first char of a string or an int, like in a declaration */
+	if (OBJECT_TypeOf(old) == OBJECT_CHAR && (OBJECT_TypeOf(o) == OBJECT_STRING || OBJECT_TypeOf(o) == OBJECT_INT)) {
+		object *o2 = OBJECT_NewChar(OBJECT_TypeOf(o) == OBJECT_STRING ? OBJECT_StringChars(o)[0] : (char)OBJECT_IntValue(o));
+		STORAGE_Discard(o);
+		o = o2;
+	}
+	/* the variable keeps its type */
+	if (OBJECT_TypeOf(o) != OBJECT_TypeOf(old) || (OBJECT_TypeOf(o) == OBJECT_ARRAY
+		&& ((arrayObject*)o->value)->array_type != ((arrayObject*)old->value)->array_type)) {
+		/* create runtime error */
+		i->e = ERROR_RuntimeError("Mismatched Types", n->lineno, n->colno);
+		/* free the value */
+		STORAGE_Discard(o);
+		return NULL; /* exit */
+	}
+
+	/* if an object is not registered, register it; a new string is owned by the variable */
+	if (!STORAGE_Find(o)) {
+		o = STORAGE_Register(o);
+		if (OBJECT_TypeOf(o) == OBJECT_STRING) o->flags |= OBJECT_OWNED;
+	}
+	/* an owned string given to another variable is owned by neither */
+	else if (OBJECT_IsOwned(o) && old != o)
+		OBJECT_Disown(o);
+
+	/* the local if it has been declared, otherwise the global (which was found above) */
+	if (n->d > 0 && i->frame[i->fp + n->d - 1] != NULL)
+		i->frame[i->fp + n->d - 1] = o;
+	else
+		NAMES_Find((char*)n->tokens[0]->value, &n->slot)->value = o;
 
 	/* return object */
 	return o;
 }
 
 object *INTERPRETER_VisitVarAccess(interpreter *i, node *n) {
-	/* get the value from the names list */
-	object *o = NAMES_Get((char*)n->tokens[0]->value);
+	/* get the value from the frame or the names list */
+	object *o = INTERPRETER_GetName(i, n);
 
 	/* undefined object */
 	if (o == NULL) {
@@ -613,6 +785,10 @@ object *INTERPRETER_VisitVarAccess(interpreter *i, node *n) {
 		return NULL; /* exit */
 	}
 
+	/* whatever reads it may keep it, unless it is the left of 'str s = s + x;'
+	and was found where s is declared (not a global found in place of a local) */
+	if (!n->b || (n->d > 0 && i->frame[i->fp + n->d - 1] != o)) OBJECT_Disown(o);
+
 	/* return object */
 	return o;
 }
@@ -622,21 +798,25 @@ object *INTERPRETER_VisitUnOp(interpreter *i, node *n) {
 	object *right = INTERPRETER_Visit(i, n->children[0]);
 	/* error from right */
 	if (i->e != NULL || right == NULL) {
-		/* free right if it isn't in storage */
-		if (!STORAGE_Find(right)) OBJECT_FreeObject(right);
+		/* free right */
+		STORAGE_Discard(right);
 		return NULL; /* exit */
 	}
 
+	/* apply the operation */
+	return INTERPRETER_UnaryOp(i, n, right);
+}
+
+object *INTERPRETER_UnaryOp(interpreter *i, node *n, object *right) {
 	object *result = NULL; /* final result */
 	if (n->tokens[0]->type == TOKEN_MINUS) {
 		/* negate it */
 		object *x = OBJECT_NewInt(-1);
 		result = OBJECT_MultedBy(right, x);
-		OBJECT_FreeObject(x);
 	}
 
 	/* free stuff */
-	if (!STORAGE_Find(right)) OBJECT_FreeObject(right);
+	STORAGE_Discard(right);
 
 	/* return result */
 	return result;
@@ -645,8 +825,12 @@ object *INTERPRETER_VisitUnOp(interpreter *i, node *n) {
 object *INTERPRETER_VisitAddress(interpreter *i, node *n) {
 	/* visit the child node */
 	object *chd = INTERPRETER_Visit(i, n->children[0]);
+	/* error or failed allocation */
+	if (chd == NULL || i->e != NULL)
+		return NULL; /* exit */
 	/* store address of object */
 	int adr = (int)chd; /* address of object* rather than object for various reasons */
+	OBJECT_Disown(chd); /* can be changed through the address */
 	/* free if needed */
 	if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
 	/* return new int */
@@ -656,8 +840,6 @@ object *INTERPRETER_VisitAddress(interpreter *i, node *n) {
 object *INTERPRETER_VisitGetItem(interpreter *i, node *n) {
 	/* visit the child node */
 	object *chd = INTERPRETER_Visit(i, n->children[0]);
-	/* get the value */
-	object *value = NAMES_Get((char*)n->tokens[0]->value);
 	/* error from child */
 	if (i->e != NULL || chd == NULL) {
 		/* free child if it isn't null and isn't in storage */
@@ -666,6 +848,13 @@ object *INTERPRETER_VisitGetItem(interpreter *i, node *n) {
 			OBJECT_FreeObject(chd);
 		return NULL; /* exit */
 	}
+	/* get the item */
+	return INTERPRETER_GetItem(i, n, chd);
+}
+
+object *INTERPRETER_GetItem(interpreter *i, node *n, object *chd) {
+	/* get the value */
+	object *value = INTERPRETER_GetName(i, n);
 	/* unknown value from value */
 	if (value == NULL) {
 		/* create error */
@@ -674,10 +863,10 @@ object *INTERPRETER_VisitGetItem(interpreter *i, node *n) {
 		if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
 		return NULL; /* exit */
 	}
-	/* array */
-	if (value->type == OBJECT_ARRAY) {
+	/* array or vector */
+	if (OBJECT_TypeOf(value) == OBJECT_ARRAY || OBJECT_TypeOf(value) == OBJECT_VECTOR) {
 		/* int value invalid */
-		if (chd->type != OBJECT_INT) {
+		if (OBJECT_TypeOf(chd) != OBJECT_INT) {
 			/* create error */
 			i->e = ERROR_RuntimeError("Index must be Integer", n->lineno, n->colno);
 			/* free value and child */
@@ -686,11 +875,11 @@ object *INTERPRETER_VisitGetItem(interpreter *i, node *n) {
 			return NULL; /* exit */
 		}
 		/* store index */
-		int idx = *(int*)chd->value;
+		int idx = OBJECT_IntValue(chd);
 		/* get array */
 		arrayObject *a = (arrayObject*)value->value;
 		/* invalid index */
-		if (idx >= a->size) {
+		if (idx < 0 || idx >= a->size) {
 			/* create error */
 			i->e = ERROR_RuntimeError("Index greater than limit of array", n->lineno, n->colno);
 			/* free value and child */
@@ -703,12 +892,12 @@ object *INTERPRETER_VisitGetItem(interpreter *i, node *n) {
 		/* free child object */
 		if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
 		/* get object */
-		return a->values[idx];
+		return OBJECT_GetArrayItem(a, idx);
 	}
 	/* string */
-	if (value->type == OBJECT_STRING) {
+	if (OBJECT_TypeOf(value) == OBJECT_STRING) {
 		/* int value invalid */
-		if (chd->type != OBJECT_INT) {
+		if (OBJECT_TypeOf(chd) != OBJECT_INT) {
 			/* create error */
 			i->e = ERROR_RuntimeError("Index must be Integer", n->lineno, n->colno);
 			/* free value and child */
@@ -717,16 +906,39 @@ object *INTERPRETER_VisitGetItem(interpreter *i, node *n) {
 			return NULL; /* exit */
 		}
 		/* store index */
-		int idx = *(int*)chd->value;
+		int idx = OBJECT_IntValue(chd);
 		/* free child object */
 		if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
 		/* return new char */
-		return OBJECT_NewChar(((char*)value->value)[idx]);
+		return OBJECT_NewChar(OBJECT_StringChars(value)[idx]);
+	}
+	/* map */
+	if (OBJECT_TypeOf(value) == OBJECT_MAP) {
+		/* expecting string or int */
+		if (!OBJECT_IsKey(chd)) {
+			/* create error */
+			i->e = ERROR_RuntimeError("Key must be String or Integer", n->lineno, n->colno);
+			/* free child */
+			if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
+			return NULL; /* exit */
+		}
+		/* find the key */
+		mapEntry *e = OBJECT_MapFind((mapObject*)value->value, chd);
+		/* free child object */
+		if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
+		/* unknown key */
+		if (e == NULL) {
+			/* create error */
+			i->e = ERROR_RuntimeError("Key not found", n->lineno, n->colno);
+			return NULL; /* exit */
+		}
+		/* return value of the key */
+		return e->value;
 	}
 	/* instance */
-	if (value->type == OBJECT_INSTANCE) {
+	if (OBJECT_TypeOf(value) == OBJECT_INSTANCE) {
 		/* expecting string */
-		if (chd->type != OBJECT_STRING) {
+		if (OBJECT_TypeOf(chd) != OBJECT_STRING) {
 			/* create error */
 			i->e = ERROR_RuntimeError("Index must be String", n->lineno, n->colno);
 			/* free value and child */
@@ -735,7 +947,7 @@ object *INTERPRETER_VisitGetItem(interpreter *i, node *n) {
 			return NULL; /* exit */
 		}
 		/* get string value */
-		char *key = (char*)chd->value;
+		char *key = OBJECT_StringChars(chd);
 		/* get instance */
 		instance *inst = (instance*)value->value;
 		/* search through names and find correct one */
@@ -773,17 +985,28 @@ object *INTERPRETER_VisitSetItem(interpreter *i, node *n) {
 		/* return */
 		return NULL;
 	}
-	/* get value node */
+	/* get value node, keeping the index alive */
+	int roots = GC_RootsSz;
+	GC_PushRoot(chd);
 	object *new_value = INTERPRETER_Visit(i, n->children[1]);
+	GC_PopRoots(roots);
 	/* fail */
 	if (new_value == NULL || i->e != NULL) {
 		/* free */
 		if (new_value != NULL && !STORAGE_Find(new_value)) OBJECT_FreeObject(new_value);
+		if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
 		/* return */
 		return NULL;
 	}
+	/* set the item */
+	return INTERPRETER_SetItem(i, n, chd, new_value);
+}
+
+object *INTERPRETER_SetItem(interpreter *i, node *n, object *chd, object *new_value) {
+	/* the new value may be kept by an array or instance */
+	OBJECT_Disown(new_value);
 	/* get index */
-	object *value = NAMES_Get((char*)n->tokens[0]->value);
+	object *value = INTERPRETER_GetName(i, n);
 	/* value not found */
 	if (value == NULL) {
 		/* create error */
@@ -794,10 +1017,10 @@ object *INTERPRETER_VisitSetItem(interpreter *i, node *n) {
 		/* return */
 		return NULL;
 	}
-	/* array */
-	if (value->type == OBJECT_ARRAY) {
+	/* array or vector */
+	if (OBJECT_TypeOf(value) == OBJECT_ARRAY || OBJECT_TypeOf(value) == OBJECT_VECTOR) {
 		/* int value invalid */
-		if (chd->type != OBJECT_INT) {
+		if (OBJECT_TypeOf(chd) != OBJECT_INT) {
 			/* create error */
 			i->e = ERROR_RuntimeError("Index must be Integer", n->lineno, n->colno);
 			/* free value and child */
@@ -807,11 +1030,11 @@ object *INTERPRETER_VisitSetItem(interpreter *i, node *n) {
 			return NULL; /* exit */
 		}
 		/* store index */
-		int idx = *(int*)chd->value;
+		int idx = OBJECT_IntValue(chd);
 		/* get array */
 		arrayObject *a = (arrayObject*)value->value;
 		/* invalid index */
-		if (idx >= a->size) {
+		if (idx < 0 || idx >= a->size) {
 			/* create error */
 			i->e = ERROR_RuntimeError("Index greater than limit of array", n->lineno, n->colno);
 			/* free value and child */
@@ -820,17 +1043,26 @@ object *INTERPRETER_VisitSetItem(interpreter *i, node *n) {
 			if (!STORAGE_Find(value)) OBJECT_FreeObject(value);
 			return NULL; /* exit */
 		}
-		if (!STORAGE_Find(new_value)) a->values[idx] = STORAGE_Register(new_value);
-		else a->values[idx] = new_value;
+		/* objects are kept by the array, ints and chars are copied into it */
+		if (a->values != NULL && !STORAGE_Find(new_value)) new_value = STORAGE_Register(new_value);
+		/* set the value */
+		if (!OBJECT_SetArrayItem(a, idx, new_value)) {
+			/* create error */
+			i->e = ERROR_RuntimeError("Mismatched Types", n->lineno, n->colno);
+			/* free value and child */
+			if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
+			if (!STORAGE_Find(new_value)) OBJECT_FreeObject(new_value);
+			return NULL; /* exit */
+		}
 		/* free child object */
 		if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
-		/* get object */
-		return a->values[idx];
+		/* return the value */
+		return new_value;
 	}
 	/* string */
-	if (value->type == OBJECT_STRING) {
+	if (OBJECT_TypeOf(value) == OBJECT_STRING) {
 		/* int value invalid */
-		if (chd->type != OBJECT_INT) {
+		if (OBJECT_TypeOf(chd) != OBJECT_INT) {
 			/* create error */
 			i->e = ERROR_RuntimeError("Index must be Integer", n->lineno, n->colno);
 			/* free value and child */
@@ -840,31 +1072,67 @@ object *INTERPRETER_VisitSetItem(interpreter *i, node *n) {
 			return NULL; /* exit */
 		}
 		/* store index */
-		int idx = *(int*)chd->value;
+		int idx = OBJECT_IntValue(chd);
+		/* outside of the string's buffer */
+		if (idx < 0 || idx >= OBJECT_String(value)->cap) {
+			/* create error */
+			i->e = ERROR_RuntimeError("Index greater than limit of string", n->lineno, n->colno);
+			/* free value and child */
+			if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
+			if (!STORAGE_Find(new_value)) OBJECT_FreeObject(new_value);
+			return NULL; /* exit */
+		}
+		/* shared literals can't be changed, so the variable gets its own copy */
+		if (OBJECT_IsShared(value)) {
+			value = STORAGE_Register(value);
+			INTERPRETER_SetName(i, n, value);
+		}
+		stringObject *str = OBJECT_String(value);
 		/* if string get first char */
-		if (new_value->type == OBJECT_STRING) {
+		if (OBJECT_TypeOf(new_value) == OBJECT_STRING) {
 			/* set char */
-			((char*)value->value)[idx] = ((char*)new_value->value)[0];
+			str->chars[idx] = OBJECT_StringChars(new_value)[0];
 		}
 		/* char object */
-		else if (new_value->type == OBJECT_CHAR) {
+		else if (OBJECT_TypeOf(new_value) == OBJECT_CHAR) {
 			/* set char */
-			((char*)value->value)[idx] = (*(char*)new_value->value);
+			str->chars[idx] = OBJECT_CharValue(new_value);
 		}
+		/* a null term ends the string there, and replacing its null term joins it to the chars after it */
+		if (str->chars[idx] == '\0' && idx < str->len) str->len = idx;
+		else if (str->chars[idx] != '\0' && idx == str->len) str->len = idx + strlen(str->chars + idx);
+		str->hash = 0; /* chars changed */
 		/* free stuff */
 		if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
 		if (!STORAGE_Find(new_value)) OBJECT_FreeObject(new_value);
 		/* create char object */
-		object *chr = OBJECT_NewChar(((char*)value->value)[idx]);
-		/* free child object */
-		if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
+		object *chr = OBJECT_NewChar(str->chars[idx]);
 		/* return new char */
 		return chr;
 	}
+	/* map */
+	if (OBJECT_TypeOf(value) == OBJECT_MAP) {
+		/* requires string or int */
+		if (!OBJECT_IsKey(chd)) {
+			/* create error */
+			i->e = ERROR_RuntimeError("Key must be String or Integer", n->lineno, n->colno);
+			/* free child and value */
+			if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
+			if (!STORAGE_Find(new_value)) OBJECT_FreeObject(new_value);
+			return NULL; /* exit */
+		}
+		/* values are kept by the map, keys are copied into it */
+		if (!STORAGE_Find(new_value)) new_value = STORAGE_Register(new_value);
+		OBJECT_MapSet((mapObject*)value->value, chd, new_value);
+		/* free child object */
+		if (!STORAGE_Find(chd)) OBJECT_FreeObject(chd);
+		/* return */
+		return new_value;
+	}
 	/* instance */
-	if (value->type == OBJECT_INSTANCE) {
+	if (OBJECT_TypeOf(value) == OBJECT_INSTANCE) {
 		/* requires string */
-		if (chd->type != OBJECT_STRING) {
+		if (OBJECT_TypeOf(chd) != OBJECT_STRING) {
 			/* create error */
 			i->e = ERROR_RuntimeError("Index must be String", n->lineno, n->colno);
 			/* free value and child */
@@ -874,7 +1142,7 @@ object *INTERPRETER_VisitSetItem(interpreter *i, node *n) {
 			return NULL; /* exit */
 		}
 		/* get string value */
-		char *key = (char*)chd->value;
+		char *key = OBJECT_StringChars(chd);
 		/* get instance */
 		instance *inst = (instance*)value->value;
 		/* search for name */
@@ -905,123 +1173,190 @@ object *INTERPRETER_VisitSetItem(interpreter *i, node *n) {
 	return NULL;
 }
 
+int INTERPRETER_Comparison(node *n) {
+	/* only binary operations compare */
+	if (n->type != NODE_BINOP) return -1;
+	/* operation token */
+	int type = n->tokens[0]->type;
+	if (type == TOKEN_EE) return OBJECT_CMP_EQ;
+	if (type == TOKEN_NE) return OBJECT_CMP_NE;
+	if (type == TOKEN_LT) return OBJECT_CMP_LT;
+	if (type == TOKEN_GT) return OBJECT_CMP_GT;
+	/* not a comparison */
+	return -1;
+}
+
+int INTERPRETER_Compare(interpreter *i, node *n, object *left, object *right) {
+	/* compare the values */
+	int r = OBJECT_Compare(left, right, INTERPRETER_Comparison(n));
+	/* values can't be compared */
+	if (r < 0)
+		i->e = ERROR_RuntimeError("Illegal Operation", n->lineno, n->colno);
+	/* free left and right */
+	STORAGE_Discard(left);
+	STORAGE_Discard(right);
+	return r;
+}
+
+int INTERPRETER_Condition(interpreter *i, node *n) {
+	/* comparisons give their truth value without making an int */
+	if (INTERPRETER_Comparison(n) >= 0) {
+		/* get the left and right values */
+		object *left = INTERPRETER_Visit(i, n->children[0]);
+		/* error from left */
+		if (i->e != NULL || left == NULL) {
+			STORAGE_Discard(left);
+			return -1;
+		}
+		/* keep left alive while right is visited */
+		int roots = GC_RootsSz;
+		GC_PushRoot(left);
+		object *right = INTERPRETER_Visit(i, n->children[1]);
+		GC_PopRoots(roots);
+		/* error from right */
+		if (i->e != NULL || right == NULL) {
+			STORAGE_Discard(right);
+			STORAGE_Discard(left);
+			return -1;
+		}
+		/* compare */
+		return INTERPRETER_Compare(i, n, left, right);
+	}
+	/* any other value */
+	object *o = INTERPRETER_Visit(i, n);
+	/* error or failed allocation */
+	if (i->e != NULL || o == NULL) {
+		STORAGE_Discard(o);
+		return -1;
+	}
+	/* get truth value */
+	int truth = OBJECT_Truth(o);
+	/* free the value before the statements run, since they may collect it */
+	STORAGE_Discard(o);
+	return truth;
+}
+
 object *INTERPRETER_VisitIfNode(interpreter *i, node *n) {
-	/* get the comparison */
-	object *comp = INTERPRETER_Visit(i, n->children[0]);
+	/* get the truth value of the comparison */
+	int truth = INTERPRETER_Condition(i, n->children[0]);
 	/* error */
-	if (i->e != NULL || comp == NULL)
+	if (truth < 0)
 		return NULL;
 	/* if the comparison is true */
-	object *is_true = OBJECT_IsTrue(comp);
-	if (*(int*)is_true->value == 1) {
+	if (truth) {
 		/* get statements */
 		object *statements = INTERPRETER_Visit(i, n->children[1]);
 		/* error */
-		if (i->e != NULL || statements == NULL) {
-			/* free stuff */
-			if (!STORAGE_Find(comp)) OBJECT_FreeObject(comp);
-			OBJECT_FreeObject(is_true);
+		if (i->e != NULL || statements == NULL)
 			return NULL; /* exit */
-		}
 		/* free statements */
-		if (!STORAGE_Find(statements)) OBJECT_FreeObject(statements);
+		STORAGE_Discard(statements);
 	}
-	/* free comparison */
-	if (!STORAGE_Find(comp)) OBJECT_FreeObject(comp);
-	OBJECT_FreeObject(is_true);
 	/* new int */
 	return OBJECT_NewInt(1);
 }
 
 object *INTERPRETER_VisitWhile(interpreter *i, node *n) {
-	/* visit comparison */
-	object *comp = INTERPRETER_Visit(i, n->children[0]);
-	/* error or failed allocation */
-	if (comp == NULL || i->e != NULL)
-		return NULL; /* exit */
-	/* get truth value */
-	object *is_true = OBJECT_IsTrue(comp);
+	/* temporaries of each turn are released together */
+	arenaMark mark = ARENA_Mark(STORAGE_Scratch);
 	/* loop */
-	while (*(int*)is_true->value == 1) {
+	for (;;) {
+		/* get the truth value of the comparison */
+		int truth = INTERPRETER_Condition(i, n->children[0]);
+		/* error or failed allocation */
+		if (truth < 0)
+			return NULL; /* exit */
+		/* comparison is false */
+		if (!truth) break;
 		/* get statements */
 		object *statements = INTERPRETER_Visit(i, n->children[1]);
 		/* error */
-		if (i->e != NULL || statements == NULL) {
-			/* free stuff */
-			if (!STORAGE_Find(comp)) OBJECT_FreeObject(comp);
-			OBJECT_FreeObject(is_true);
-			return NULL; /* exit */
-		}
-		/* free comparison, is_true, and statements */
-		if (!STORAGE_Find(comp)) OBJECT_FreeObject(comp);
-		OBJECT_FreeObject(is_true);
-		if (!STORAGE_Find(statements)) OBJECT_FreeObject(statements);
-		/* get next comparison */
-		comp = INTERPRETER_Visit(i, n->children[0]);
-		/* error or failed allocation */
-		if (comp == NULL || i->e != NULL) {
-			/* free stuff */
-			if (!STORAGE_Find(statements)) OBJECT_FreeObject(statements);
-			OBJECT_FreeObject(is_true);
+		if (i->e != NULL || statements == NULL)
 			return NULL; /* exit */
-		}
-		/* get truth value */
-		is_true = OBJECT_IsTrue(comp);
+		/* free statements */
+		STORAGE_Discard(statements);
+		ARENA_Release(STORAGE_Scratch, mark);
 	}
-	/* free stuff */
-	if (!STORAGE_Find(comp)) OBJECT_FreeObject(comp);
-	if (!STORAGE_Find(is_true)) OBJECT_FreeObject(is_true);
 	/* return new int */
 	return OBJECT_NewInt(1);
 }
 
 object *INTERPRETER_VisitForLoop(interpreter *i, node *n) {
-	/* get start end tokens */
+	/* get start, end and step values */
+	int roots = GC_RootsSz;
 	object *so = INTERPRETER_Visit(i, n->children[1]);
+	/* keep start alive while end and step are visited */
+	if (so != NULL) GC_PushRoot(so);
 	object *eo = INTERPRETER_Visit(i, n->children[2]);
+	if (eo != NULL) GC_PushRoot(eo);
+	/* the step is 1 if it isn't given */
+	object *to = n->n_of_children > 3 ? INTERPRETER_Visit(i, n->children[3]) : OBJECT_NewInt(1);
+	GC_PopRoots(roots);
 	/* found error */
-	if (so == NULL || eo == NULL || i->e != NULL) {
+	if (so == NULL || eo == NULL || to == NULL || i->e != NULL) {
 		/* free stuff */
-		if (so != NULL && !STORAGE_Find(so)) OBJECT_FreeObject(so);
-		if (eo != NULL && !STORAGE_Find(eo)) OBJECT_FreeObject(eo);
-		return NULL; /* exit */
-	}
-	/* must be integers */
-	if (so->type != OBJECT_INT || eo->type != OBJECT_INT) {
-		/* create error */
-		i->e = ERROR_RuntimeError("Start and end values must be integers", n->children[1]->lineno, n->children[1]->colno);
-		/* free */
-		if (!STORAGE_Find(so)) OBJECT_FreeObject(so);
-		if (!STORAGE_Find(eo)) OBJECT_FreeObject(eo);
+		STORAGE_Discard(so);
+		STORAGE_Discard(eo);
+		STORAGE_Discard(to);
 		return NULL; /* exit */
 	}
 	/* store ints */
-	int start = *(int*)so->value;
-	int end = *(int*)eo->value;
-	/* free objects */
-	if (!STORAGE_Find(so)) OBJECT_FreeObject(so);
-	if (!STORAGE_Find(eo)) OBJECT_FreeObject(eo);
+	int start, end, step;
+	if (!INTERPRETER_ForRange(i, n, so, eo, to, &start, &end, &step))
+		return NULL; /* exit */
 	/* create an object */
 	object *o = STORAGE_Register(OBJECT_NewInt(start));
 	/* assign object to name */
-	NAMES_Assign((char*)n->tokens[0]->value, o);
-	/* while the start is less than end */
-	while (start < end) {
-		*(int*)o->value = start++; /* increment */
+	INTERPRETER_SetName(i, n, o);
+	/* temporaries of each turn are released together */
+	arenaMark mark = ARENA_Mark(STORAGE_Scratch);
+	/* while the counter hasn't reached the end, counting down if the step is negative */
+	for (; step > 0 ? start < end : start > end; start += step) {
+		/* ints can't be changed in place, so the name is given the next value */
+		o = STORAGE_Register(OBJECT_NewInt(start));
+		INTERPRETER_SetName(i, n, o);
+		/* the counter is returned even if the name is assigned something else */
+		GC_PopRoots(roots);
+		GC_PushRoot(o);
 		/* visit the statements */
 		object *st = INTERPRETER_Visit(i, n->children[0]);
 		/* error or failed allocation */
 		if (st == NULL || i->e != NULL) {
+			GC_PopRoots(roots);
 			/* exit */
 			return NULL;
 		}
 		/* free object */
-		if (!STORAGE_Find(st)) OBJECT_FreeObject(st);
+		STORAGE_Discard(st);
+		ARENA_Release(STORAGE_Scratch, mark);
 	}
+	GC_PopRoots(roots);
 	/* return */
 	return o;
 }
 
+int INTERPRETER_ForRange(interpreter *i, node *n, object *so, object *eo, object *to, int *start, int *end, int *step) {
+	/* must be integers */
+	if (OBJECT_TypeOf(so) != OBJECT_INT || OBJECT_TypeOf(eo) != OBJECT_INT)
+		/* create error */
+		i->e = ERROR_RuntimeError("Start and end values must be integers", n->children[1]->lineno, n->children[1]->colno);
+	/* the step can't be 0, or the loop would never end */
+	else if (OBJECT_TypeOf(to) != OBJECT_INT || OBJECT_IntValue(to) == 0)
+		/* create error */
+		i->e = ERROR_RuntimeError("Step must be a nonzero integer", n->children[3]->lineno, n->children[3]->colno);
+	else {
+		/* store ints */
+		*start = OBJECT_IntValue(so);
+		*end = OBJECT_IntValue(eo);
+		*step = OBJECT_IntValue(to);
+	}
+	/* free objects */
+	STORAGE_Discard(so);
+	STORAGE_Discard(eo);
+	STORAGE_Discard(to);
+	return i->e == NULL;
+}
+
 object *INTERPRETER_VisitValue(interpreter *i, node *n) {
 	/* get the value */
 	object *value = INTERPRETER_Visit(i, n->children[0]);
@@ -1031,8 +1366,13 @@ object *INTERPRETER_VisitValue(interpreter *i, node *n) {
 		if (value != NULL && !STORAGE_Find(value)) OBJECT_FreeObject(value);
 		return NULL; /* exit */
 	}
+	/* dereference it */
+	return INTERPRETER_Dereference(i, n, value);
+}
+
+object *INTERPRETER_Dereference(interpreter *i, node *n, object *value) {
 	/* expecting integer */
-	if (value->type != OBJECT_INT) {
+	if (OBJECT_TypeOf(value) != OBJECT_INT) {
 		/* create error */
 		i->e = ERROR_RuntimeError("Pointers can only exist as integers", n->lineno, n->colno);
 		/* free */
@@ -1040,7 +1380,7 @@ object *INTERPRETER_VisitValue(interpreter *i, node *n) {
 		return NULL; /* exit */
 	}
 	/* get value from object and free it if needed */
-	object *adr = (object*)(*(int*)value->value);
+	object *adr = (object*)OBJECT_IntValue(value);
 	if (!STORAGE_Find(value)) OBJECT_FreeObject(value);
 	/* return */
 	return adr;
@@ -1051,29 +1391,31 @@ object *INTERPRETER_VisitBinOp(interpreter *i, node *n) {
 	object *left = INTERPRETER_Visit(i, n->children[0]);
 	/* error from left */
 	if (i->e != NULL || left == NULL) {
-		/* free left if it isn't in storage */
-		if (left != NULL && !STORAGE_Find(left)) {
-			/* free pointer */
-			OBJECT_FreeObject(left);
-		}
+		/* free left */
+		STORAGE_Discard(left);
 		/* return */
 		return NULL;
 	}
 
+	/* keep left alive while right is visited */
+	int roots = GC_RootsSz;
+	GC_PushRoot(left);
 	object *right = INTERPRETER_Visit(i, n->children[1]);
+	GC_PopRoots(roots);
 	/* error from right */
 	if (i->e != NULL || right == NULL) {
-		/* free right if it isn't in storage */
-		if (right != NULL && !STORAGE_Find(right)) {
-			/* free pointer */
-			OBJECT_FreeObject(right);
-		}
-		/* free left */
-		if (!STORAGE_Find(left)) OBJECT_FreeObject(left);
+		/* free left and right */
+		STORAGE_Discard(right);
+		STORAGE_Discard(left);
 		/* return */
 		return NULL;
 	}
 
+	/* apply the operation */
+	return INTERPRETER_BinaryOp(i, n, left, right);
+}
+
+object *INTERPRETER_BinaryOp(interpreter *i, node *n, object *left, object *right) {
 	/* get operation token */
 	token *t = n->tokens[0];
 
@@ -1081,9 +1423,20 @@ object *INTERPRETER_VisitBinOp(interpreter *i, node *n) {
 	object *r = NULL;
 
 	/* '+' */
-	if (t->type == TOKEN_PLUS)
+	if (t->type == TOKEN_PLUS) {
+		/* a string that nothing else can see is appended to in place:
+		either a string made by this expression, or the owned string
+		of the variable in 'str s = s + x;' (marked by the parser) */
+		if (OBJECT_TypeOf(left) == OBJECT_STRING && OBJECT_TypeOf(right) == OBJECT_STRING && left != right
+			&& ((n->b && OBJECT_IsOwned(left)) || (!OBJECT_IsShared(left) && !STORAGE_Find(left)))) {
+			OBJECT_StringAppend(left, OBJECT_StringChars(right), OBJECT_StringLen(right));
+			/* free right */
+			STORAGE_Discard(right);
+			return left;
+		}
 		/* get result */
 		r = OBJECT_AddedTo(left, right);
+	}
 	/* '-' */
 	else if (t->type == TOKEN_MINUS)
 		/* get result */
@@ -1123,13 +1476,9 @@ object *INTERPRETER_VisitBinOp(interpreter *i, node *n) {
 		i->e = ERROR_RuntimeError("Illegal Operation", n->lineno, n->colno);
 	}
 
-	/* free left and right if they aren't registered */
-	if (!STORAGE_Find(left))
-		/* free left */
-		OBJECT_FreeObject(left);
-	if (!STORAGE_Find(right))
-		/* free right */
-		OBJECT_FreeObject(right);
+	/* free left and right */
+	STORAGE_Discard(left);
+	STORAGE_Discard(right);
 
 	/* return result */
 	return r;
@@ -0,0 +1,231 @@
+/* see vm.h for documentation */
+#include "vm.h" /* our header */
+#include "compiler.h" /* opcodes */
+#include "interpreter.h" /* shared operations */
+#include "objectio.h" /* printing */
+#include "object.h" /* objects */
+#include "storage.h" /* registered objects */
+#include "error.h" /* errors */
+#include "gc.h" /* garbage collector */
+
+#include <stdlib.h> /* realloc */
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+void VM_Push(interpreter *i, object *o) {
+	/* check the capacity */
+	if (i->sp >= i->stack_cap) {
+		/* realloc stack */
+		i->stack = (object**)realloc(i->stack, sizeof(object*) * i->stack_cap * 2);
+		/* update cap */
+		i->stack_cap *= 2;
+	}
+	/* add the value */
+	i->stack[i->sp++] = o;
+}
+
+object *VM_Pop(interpreter *i) {
+	/* take the top value */
+	return i->stack[--i->sp];
+}
+
+void VM_Unwind(interpreter *i, int base) {
+	/* free everything that isn't registered */
+	while (i->sp > base) {
+		object *o = VM_Pop(i);
+		if (o != NULL && !STORAGE_Find(o)) OBJECT_FreeObject(o);
+	}
+}
+
+object *VM_Execute(interpreter *i, chunk *c) {
+	int base = i->sp; /* values below this belong to the caller */
+	arenaMark mark = ARENA_Mark(STORAGE_Scratch); /* temporaries are released after each statement */
+	int *code = c->code; /* instructions */
+	int pc = 0; /* current instruction */
+	node *n; /* node of current instruction */
+	object *o, *left, *right; /* values being worked on */
+	function *f; /* function being called */
+	int argc; /* number of arguments */
+	int truth; /* result of a comparison */
+	int addr; /* address of a value */
+	int next, end, step; /* next value, end and step of a for loop */
+
+	for (;;) {
+		switch (code[pc++]) {
+			case OP_INT:
+				VM_Push(i, OBJECT_NewInt(code[pc++]));
+				break;
+			case OP_STRING:
+				VM_Push(i, INTERPRETER_VisitString(i, c->nodes[code[pc++]]));
+				break;
+			case OP_LOAD:
+				o = INTERPRETER_VisitVarAccess(i, c->nodes[code[pc++]]);
+				/* undefined variable */
+				if (o == NULL) goto fail;
+				VM_Push(i, o);
+				break;
+			case OP_DECLARE:
+				o = INTERPRETER_Declare(i, c->nodes[code[pc++]], VM_Pop(i));
+				if (o == NULL || i->e != NULL) goto fail;
+				VM_Push(i, o);
+				break;
+			case OP_ASSIGN:
+				o = INTERPRETER_Assign(i, c->nodes[code[pc++]], VM_Pop(i));
+				if (o == NULL || i->e != NULL) goto fail;
+				VM_Push(i, o);
+				break;
+			case OP_BINARY:
+				right = VM_Pop(i);
+				left = VM_Pop(i);
+				o = INTERPRETER_BinaryOp(i, c->nodes[code[pc++]], left, right);
+				if (o == NULL || i->e != NULL) goto fail;
+				VM_Push(i, o);
+				break;
+			case OP_NEGATE:
+				o = INTERPRETER_UnaryOp(i, c->nodes[code[pc++]], VM_Pop(i));
+				if (o == NULL || i->e != NULL) goto fail;
+				VM_Push(i, o);
+				break;
+			case OP_PRINT:
+				/* value stays on the stack */
+				OBJECTIO_PrintObject(i->stack[i->sp-1]);
+				break;
+			case OP_POP:
+				STORAGE_Discard(VM_Pop(i));
+				/* end of a statement; every value in use is on the stack, and none are temporaries */
+				ARENA_Release(STORAGE_Scratch, mark);
+				GC_Check();
+				break;
+			case OP_JUMP:
+				pc = code[pc];
+				break;
+			case OP_JUMP_IF_FALSE:
+				o = VM_Pop(i);
+				/* get truth value */
+				if (OBJECT_Truth(o)) pc++;
+				else pc = code[pc];
+				/* free stuff */
+				STORAGE_Discard(o);
+				break;
+			case OP_JUMP_IF_NOT:
+				right = VM_Pop(i);
+				left = VM_Pop(i);
+				/* compare without making an int */
+				truth = INTERPRETER_Compare(i, c->nodes[code[pc++]], left, right);
+				if (truth < 0) goto fail;
+				if (truth) pc++;
+				else pc = code[pc];
+				break;
+			case OP_CALL:
+				n = c->nodes[code[pc++]];
+				argc = code[pc++];
+				/* get the function */
+				o = INTERPRETER_GetCallable(i, n);
+				if (o == NULL) goto fail;
+				/* check and register arguments */
+				if (OBJECT_TypeOf(o) == OBJECT_FUNCTION) {
+					f = (function*)o->value;
+					for (int k = 0; k < argc; k++) {
+						object **arg = &i->stack[i->sp - argc + k];
+						if (!INTERPRETER_CheckArgument(i, n, f, k, *arg)) goto fail;
+						if (!OBJECT_IsImmediate(*arg) && !STORAGE_Find(*arg)) *arg = STORAGE_Register(*arg);
+						OBJECT_Disown(*arg); /* the argument can see it too */
+					}
+				}
+				/* call */
+				o = INTERPRETER_CallFunction(i, n, o, &i->stack[i->sp - argc]);
+				if (o == NULL || i->e != NULL) goto fail;
+				/* arguments are no longer needed */
+				VM_Unwind(i, i->sp - argc);
+				VM_Push(i, o);
+				break;
+			case OP_GETITEM:
+				o = INTERPRETER_GetItem(i, c->nodes[code[pc++]], VM_Pop(i));
+				if (o == NULL || i->e != NULL) goto fail;
+				VM_Push(i, o);
+				break;
+			case OP_SETITEM:
+				right = VM_Pop(i);
+				left = VM_Pop(i);
+				o = INTERPRETER_SetItem(i, c->nodes[code[pc++]], left, right);
+				if (o == NULL || i->e != NULL) goto fail;
+				VM_Push(i, o);
+				break;
+			case OP_ADDRESS:
+				o = VM_Pop(i);
+				/* address of object* rather than object */
+				addr = (int)o;
+				OBJECT_Disown(o); /* can be changed through the address */
+				if (!STORAGE_Find(o)) OBJECT_FreeObject(o);
+				VM_Push(i, OBJECT_NewInt(addr));
+				break;
+			case OP_VALUE:
+				o = INTERPRETER_Dereference(i, c->nodes[code[pc++]], VM_Pop(i));
+				if (o == NULL || i->e != NULL) goto fail;
+				VM_Push(i, o);
+				break;
+			case OP_SIZEOF:
+				o = INTERPRETER_SizeOf(i, c->nodes[code[pc++]], VM_Pop(i));
+				if (o == NULL || i->e != NULL) goto fail;
+				VM_Push(i, o);
+				break;
+			case OP_FOR_INIT:
+				n = c->nodes[code[pc++]];
+				o = VM_Pop(i); /* step */
+				right = VM_Pop(i); /* end */
+				left = VM_Pop(i); /* start */
+				/* check the values and free them */
+				if (!INTERPRETER_ForRange(i, n, left, right, o, &next, &end, &step)) goto fail;
+				/* counter, end, next value and step are kept on the stack */
+				o = STORAGE_Register(OBJECT_NewInt(next));
+				INTERPRETER_SetName(i, n, o);
+				VM_Push(i, o);
+				VM_Push(i, OBJECT_NewInt(end));
+				VM_Push(i, OBJECT_NewInt(next));
+				VM_Push(i, OBJECT_NewInt(step));
+				break;
+			case OP_FOR_NEXT:
+				n = c->nodes[code[pc++]];
+				/* while the next value hasn't reached the end, counting down if the step is negative */
+				next = OBJECT_IntValue(i->stack[i->sp-2]);
+				step = OBJECT_IntValue(i->stack[i->sp-1]);
+				end = OBJECT_IntValue(i->stack[i->sp-3]);
+				if (step > 0 ? next < end : next > end) {
+					/* ints can't be changed in place, so the counter is replaced */
+					o = STORAGE_Register(OBJECT_NewInt(next));
+					i->stack[i->sp-4] = o;
+					INTERPRETER_SetName(i, n, o);
+					/* advance the next value */
+					left = i->stack[i->sp-2];
+					i->stack[i->sp-2] = OBJECT_NewInt(next + step);
+					OBJECT_FreeObject(left);
+					pc++;
+				}
+				else
+					pc = code[pc];
+				break;
+			case OP_FOR_END:
+				/* leave the counter */
+				VM_Unwind(i, i->sp - 3);
+				break;
+			case OP_VISIT:
+				o = INTERPRETER_Visit(i, c->nodes[code[pc++]]);
+				if (o == NULL || i->e != NULL) goto fail;
+				VM_Push(i, o);
+				break;
+			case OP_RETURN:
+				return VM_Pop(i);
+		}
+	}
+
+fail:
+	/* free anything left by this chunk */
+	VM_Unwind(i, base);
+	return NULL;
+}
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
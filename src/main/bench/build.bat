@@ -0,0 +1,2 @@
+@echo off
+gcc -m32 -I "../../include/" -o names names.c "../../objects/object.c" "../../parser/token.c" "../../parser/lexer.c" "../../utils/filelib.c" "../../utils/arena.c" "../../utils/slab.c" "../../utils/storage.c" "../../utils/gc.c" "../../objects/objectio.c" "../../objects/strlib.c" "../../objects/veclib.c" "../../objects/maplib.c" "../../parser/parser.c" "../../parser/error.c" "../../parser/node.c" "../../interpreter/interpreter.c" "../../interpreter/compiler.c" "../../interpreter/vm.c" "../../utils/run.c" "../../utils/module.c" "../../utils/cache.c" "../../utils/names.c"
\ No newline at end of file
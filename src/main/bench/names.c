@@ -0,0 +1,51 @@
+/* benchmark of the name table. for each table size, fills the
+table with that many globals and then times looking them up in
+turn, so the cost of a lookup can be seen as the table grows.
+build with "./build.sh" (or "build" on windows) in this folder,
+then run "./names". */
+#include "adamite.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_LOOKUPS 2000000 /* lookups timed for each table size */
+
+int main(int argc, char **argv) {
+	/* table sizes to time */
+	int sizes[] = {10, 80, 1000, 10000, 50000};
+	int n_of_sizes = sizeof(sizes) / sizeof(int);
+	/* initialise storage */
+	STORAGE_Init();
+	printf("   names   ns/lookup\n");
+	for (int s = 0; s < n_of_sizes; s++) {
+		int sz = sizes[s];
+		/* names v0, v1, ... in a fresh table */
+		NAMES_Init();
+		char **names = (char**)malloc(sizeof(char*) * sz);
+		for (int k = 0; k < sz; k++) {
+			names[k] = (char*)malloc(16);
+			sprintf(names[k], "v%d", k);
+			NAMES_Assign(names[k], STORAGE_Register(OBJECT_NewInt(k)));
+		}
+		/* look every name up in turn */
+		long found = 0;
+		clock_t start = clock();
+		for (int k = 0; k < BENCH_LOOKUPS; k++)
+			found += NAMES_Get(names[k % sz]) != NULL;
+		double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+		/* every name must have been found */
+		if (found != BENCH_LOOKUPS) {
+			printf("lookup failed at %d names\n", sz);
+			return 1;
+		}
+		printf("%8d   %9.1f\n", sz, secs * 1e9 / BENCH_LOOKUPS);
+		/* free stuff */
+		for (int k = 0; k < sz; k++)
+			free(names[k]);
+		free(names);
+		NAMES_FreeAll();
+	}
+	/* free the objects */
+	STORAGE_FreeAll();
+	return 0;
+}
@@ -1,2 +1,2 @@
 @echo off
-gcc -m32 -I "../include/" -o main main.c "../objects/object.c" "../parser/token.c" "../parser/lexer.c" "../utils/filelib.c" "../utils/storage.c" "../objects/objectio.c" "../parser/parser.c" "../parser/error.c" "../parser/node.c" "../interpreter/interpreter.c" "../utils/run.c" "../utils/names.c"
\ No newline at end of file
+gcc -m32 -I "../include/" -o main main.c "../objects/object.c" "../parser/token.c" "../parser/lexer.c" "../utils/filelib.c" "../utils/arena.c" "../utils/slab.c" "../utils/storage.c" "../utils/gc.c" "../objects/objectio.c" "../objects/strlib.c" "../objects/veclib.c" "../objects/maplib.c" "../parser/parser.c" "../parser/error.c" "../parser/node.c" "../interpreter/interpreter.c" "../interpreter/compiler.c" "../interpreter/vm.c" "../utils/run.c" "../utils/module.c" "../utils/cache.c" "../utils/names.c"
\ No newline at end of file
@@ -2,15 +2,57 @@
 #include "adamite.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 int main(int argc, char **argv) {
 	/* initialise storage */
 	STORAGE_Init();
 	/* initialise names */
 	NAMES_Init();
+	/* assign builtin functions */
+	STRLIB_Init();
+	VECLIB_Init();
+	MAPLIB_Init();
+	/* initialise garbage collector */
+	GC_Init();
+	/* initialise module cache */
+	MODULE_Init();
+	CACHE_Enabled = 1;
+	int gc_stats = 0; /* print collector statistics at the end */
 
-	/* filename is first argument passed */
-	if (argc < 2) {
+	/* read options before the filename */
+	int arg = 1;
+	while (arg < argc && argv[arg][0] == '-') {
+		/* run on the bytecode vm */
+		if (!strcmp(argv[arg], "-vm"))
+			RUN_Mode = RUN_VM;
+		/* keep every object until the end of the program */
+		else if (!strcmp(argv[arg], "-nogc"))
+			GC_Enabled = 0;
+		/* print collector statistics */
+		else if (!strcmp(argv[arg], "-gcstats"))
+			gc_stats = 1;
+		/* always lex and parse files, without reading or writing caches */
+		else if (!strcmp(argv[arg], "-nocache"))
+			CACHE_Enabled = 0;
+		/* search a directory for includes */
+		else if (!strcmp(argv[arg], "-I") && arg + 1 < argc)
+			MODULE_AddPath(argv[++arg]);
+		else if (!strncmp(argv[arg], "-I", 2) && argv[arg][2])
+			MODULE_AddPath(argv[arg] + 2);
+		/* unknown option */
+		else {
+			printf("Unknown option: %s\n", argv[arg]);
+			return 2;
+		}
+		arg++;
+	}
+
+	/* then search the directories in ADAMITE_PATH */
+	MODULE_AddPaths(getenv("ADAMITE_PATH"));
+
+	/* filename is first argument passed after options */
+	if (arg >= argc) {
 		/* print error */
 		printf("Filename not specified.\n");
 
@@ -18,15 +60,29 @@ int main(int argc, char **argv) {
 		return 2;
 	}
 	/* otherwise, get filename */
-	char *fname = argv[1];
+	char *fname = argv[arg];
 
 	/* get error code */
 	int code = run(fname);
 
+	/* print collector and slab statistics */
+	if (gc_stats) {
+		GC_PrintStats();
+		SLAB_PrintStats();
+	}
+
+	/* free modules */
+	MODULE_FreeAll();
 	/* free storage */
 	STORAGE_FreeAll();
+	/* free string literals */
+	OBJECT_FreeLiterals();
 	/* free names */
 	NAMES_FreeAll();
+	/* free garbage collector */
+	GC_FreeAll();
+	/* free slabs, now that every object is gone */
+	SLAB_FreeAll();
 
 	/* print error code */
 	printf("Finished with code (%d)\n", code);
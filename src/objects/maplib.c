@@ -0,0 +1,102 @@
+/* see maplib.h for documentation */
+#include "maplib.h" /* our header */
+#include "object.h" /* objects */
+#include "storage.h" /* registered values */
+#include "names.h" /* assigning the functions */
+
+#include <stdlib.h> /* NULL */
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+void MAPLIB_Init() {
+	/* argument names and types of each function */
+	const char *map_names[] = {"m", "key", "x"};
+	const uint8_t map_types[] = {OBJECT_MAP, OBJECT_ANY, OBJECT_ANY};
+	/* assign the functions */
+	NAMES_Assign((char*)"mapnew", STORAGE_Register(OBJECT_NewNative("mapnew", OBJECT_MAP, NULL, NULL, 0, MAPLIB_New)));
+	NAMES_Assign((char*)"mapset", STORAGE_Register(OBJECT_NewNative("mapset", OBJECT_ANY, map_names, map_types, 3, MAPLIB_Set)));
+	NAMES_Assign((char*)"mapget", STORAGE_Register(OBJECT_NewNative("mapget", OBJECT_ANY, map_names, map_types, 2, MAPLIB_Get)));
+	NAMES_Assign((char*)"maphas", STORAGE_Register(OBJECT_NewNative("maphas", OBJECT_INT, map_names, map_types, 2, MAPLIB_Has)));
+	NAMES_Assign((char*)"mapdel", STORAGE_Register(OBJECT_NewNative("mapdel", OBJECT_INT, map_names, map_types, 2, MAPLIB_Del)));
+	NAMES_Assign((char*)"maplen", STORAGE_Register(OBJECT_NewNative("maplen", OBJECT_INT, map_names, map_types, 1, MAPLIB_Len)));
+	NAMES_Assign((char*)"mapkeys", STORAGE_Register(OBJECT_NewNative("mapkeys", OBJECT_VECTOR, map_names, map_types, 1, MAPLIB_Keys)));
+}
+
+object *MAPLIB_New(object **args, const char **err) {
+	return OBJECT_NewMap();
+}
+
+object *MAPLIB_Set(object **args, const char **err) {
+	/* strings and ints only */
+	if (!OBJECT_IsKey(args[1])) {
+		*err = "Key must be String or Integer";
+		return NULL;
+	}
+	/* arguments are already registered, so the value can be kept as it is */
+	OBJECT_MapSet((mapObject*)args[0]->value, args[1], args[2]);
+	return args[2];
+}
+
+object *MAPLIB_Get(object **args, const char **err) {
+	/* strings and ints only */
+	if (!OBJECT_IsKey(args[1])) {
+		*err = "Key must be String or Integer";
+		return NULL;
+	}
+	mapEntry *e = OBJECT_MapFind((mapObject*)args[0]->value, args[1]);
+	/* unknown key */
+	if (e == NULL) {
+		*err = "Key not found";
+		return NULL;
+	}
+	return e->value;
+}
+
+object *MAPLIB_Has(object **args, const char **err) {
+	/* anything else is never a key */
+	if (!OBJECT_IsKey(args[1])) return OBJECT_NewInt(0);
+	return OBJECT_NewInt(OBJECT_MapFind((mapObject*)args[0]->value, args[1]) != NULL);
+}
+
+object *MAPLIB_Del(object **args, const char **err) {
+	/* anything else is never a key */
+	if (!OBJECT_IsKey(args[1])) return OBJECT_NewInt(0);
+	return OBJECT_NewInt(OBJECT_MapRemove((mapObject*)args[0]->value, args[1]));
+}
+
+object *MAPLIB_Len(object **args, const char **err) {
+	return OBJECT_NewInt(((mapObject*)args[0]->value)->sz);
+}
+
+object *MAPLIB_Keys(object **args, const char **err) {
+	mapObject *m = (mapObject*)args[0]->value;
+	object *v = OBJECT_NewVector();
+	if (v == NULL) return NULL;
+	arrayObject *a = (arrayObject*)v->value;
+	/* ints are kept in one buffer if every key is an int; otherwise keys are objects */
+	a->array_type = OBJECT_NONE;
+	for (int k = 0; k < m->cap; k++) {
+		if (m->entries[k].key == NULL) continue;
+		int type = OBJECT_TypeOf(m->entries[k].key);
+		/* string and int keys together can only be kept as objects of any type */
+		if (a->array_type == OBJECT_NONE) a->array_type = type;
+		else if (a->array_type != type) a->array_type = OBJECT_ANY;
+	}
+	if (a->array_type == OBJECT_NONE) a->array_type = OBJECT_INT;
+	OBJECT_VectorReserve(a, m->sz > 0 ? m->sz : 1);
+	/* copies of the keys, registered like the values of a vector */
+	for (int k = 0; k < m->cap; k++) {
+		object *key = m->entries[k].key;
+		if (key == NULL) continue;
+		if (OBJECT_TypeOf(key) == OBJECT_STRING)
+			key = STORAGE_Register(OBJECT_NewStringLen(OBJECT_StringChars(key), OBJECT_StringLen(key)));
+		OBJECT_VectorPush(a, key);
+	}
+	return v;
+}
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
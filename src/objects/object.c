@@ -2,6 +2,8 @@
 #include "memory.h" /* memory management stuff */
 #include "object.h" /* our header */
 #include "storage.h" /* STORAGE_Find for not freeing wrong items */
+#include "compiler.h" /* freeing compiled functions */
+#include "names.h" /* hashing strings */
 
 #include <stdio.h> /* debugging */
 #include <string.h> /* strcpy */
@@ -10,19 +12,26 @@
 extern "C" {
 #endif
 
+#ifdef __cplusplus
+object **OBJECT_Literals; /* shared string literals */
+int OBJECT_LiteralsSz; /* number of shared string literals */
+int OBJECT_LiteralsCap; /* capacity of shared string literals */
+#endif
+
 object *OBJECT_NewObject(int type) {
 	/* create a new object */
-	object *obj = MEMORY_Malloc(object); /* allocate an object */
+	object *obj = MEMORY_SlabMalloc(object); /* allocate an object */
 	if (!obj || obj == NULL) /* memory allocation wasn't successful */
 		return NULL;
 
 	/* otherwise */
 	obj->type = type;
+	obj->flags = 0;
 	obj->value = NULL;
 	return obj;
 }
 
-object *OBJECT_NewFunction(char *func_name, int ret_type, char **arg_names, uint8_t *arg_types, int n_of_args, node *body_node) {
+object *OBJECT_NewFunction(char *func_name, int ret_type, char **arg_names, uint8_t *arg_types, int n_of_args, node *body_node, arena *body_arena) {
 	/* create a new function object */
 	function *f = MEMORY_Malloc(function); /* the actual function object */
 	if (!f || f == NULL) /* unsuccessful allocation */
@@ -33,7 +42,11 @@ object *OBJECT_NewFunction(char *func_name, int ret_type, char **arg_names, uint
 	f->arg_names = arg_names;
 	f->arg_types = arg_types;
 	f->body_node = body_node;
+	f->body_arena = body_arena;
 	f->n_of_args = n_of_args;
+	f->n_of_locals = n_of_args; /* locals other than arguments are added by the interpreter */
+	f->code = NULL; /* not compiled yet */
+	f->native = NULL; /* written in adamite */
 	/* create a regular object */
 	object *obj = OBJECT_NewObject(OBJECT_FUNCTION);
 	/* failed allocation */
@@ -44,6 +57,27 @@ object *OBJECT_NewFunction(char *func_name, int ret_type, char **arg_names, uint
 	return obj; /* return our object */
 }
 
+object *OBJECT_NewNative(const char *func_name, int ret_type, const char **arg_names, const uint8_t *arg_types, int n_of_args, nativeFunction native) {
+	/* copy the name, argument names and argument types, since they are freed with the function */
+	char *fname = (char*)malloc(strlen(func_name) + 1);
+	strcpy(fname, func_name);
+	char **names = (char**)malloc(sizeof(char*) * (n_of_args > 0 ? n_of_args : 1));
+	uint8_t *types = (uint8_t*)malloc(sizeof(uint8_t) * (n_of_args > 0 ? n_of_args : 1));
+	for (int k = 0; k < n_of_args; k++) {
+		names[k] = (char*)malloc(strlen(arg_names[k]) + 1);
+		strcpy(names[k], arg_names[k]);
+		types[k] = arg_types[k];
+	}
+	/* function without a body */
+	object *obj = OBJECT_NewFunction(fname, ret_type, names, types, n_of_args, NULL, NULL);
+	/* failed allocation */
+	if (obj == NULL)
+		return NULL;
+	/* assign the builtin */
+	((function*)obj->value)->native = native;
+	return obj;
+}
+
 object *OBJECT_NewArray(int type, int size) {
 	/* create new object */
 	object *obj = OBJECT_NewObject(OBJECT_ARRAY); /* allocate an object */
@@ -51,68 +85,215 @@ object *OBJECT_NewArray(int type, int size) {
 		return NULL;
 
 	/* otherwise */
-	obj->value = (void*)MEMORY_Malloc(arrayObject); /* allocate the array */
+	obj->value = (void*)MEMORY_SlabMalloc(arrayObject); /* allocate the array */
 	if (!((arrayObject*)obj->value) || ((arrayObject*)obj->value) == NULL) {
-		free(obj); /* free the object */
+		MEMORY_SlabFree(obj, object); /* free the object */
 		return NULL;
 	}
 
 	/* otherwise */
-	((arrayObject*)obj->value)->values = (object**)malloc(sizeof(object*)*size); /* allocate the *actual* array */
-	if (!((arrayObject*)obj->value)->values || ((arrayObject*)obj->value)->values == NULL) {
-		free(obj->value); /* free the arrayObject */
-		free(obj); /* free the object */
+	arrayObject *a = (arrayObject*)obj->value;
+	a->values = NULL;
+	a->ints = NULL;
+	a->chars = NULL;
+	/* ints and chars are kept in one buffer, zeroed as the default value */
+	if (type == OBJECT_INT)
+		a->ints = (int32_t*)calloc(size + 1, sizeof(int32_t));
+	else if (type == OBJECT_CHAR)
+		a->chars = (char*)calloc(size + 1, sizeof(char));
+	/* anything else is a list of objects */
+	else
+		a->values = (object**)malloc(sizeof(object*) * (size + 1));
+	/* failed allocation */
+	if (a->values == NULL && a->ints == NULL && a->chars == NULL) {
+		MEMORY_SlabFree(obj->value, arrayObject); /* free the arrayObject */
+		MEMORY_SlabFree(obj, object); /* free the object */
 		return NULL;
 	}
 
 	/* set the array type */
-	((arrayObject*)obj->value)->array_type = type;
+	a->array_type = type;
 
-	/* loop through the array and fill in the gaps */
-	for (int i = 0; i < size; i++) {
-		/* check for int */
-		if (type == OBJECT_INT)
-			/* add int */
-			((arrayObject*)obj->value)->values[i] = STORAGE_Register(OBJECT_NewInt(0)); /* default value */
+	/* loop through the list and fill in the gaps */
+	for (int i = 0; a->values != NULL && i < size; i++) {
 		/* check for string */
-		else if (type == OBJECT_STRING)
+		if (type == OBJECT_STRING)
 			/* add string */
-			((arrayObject*)obj->value)->values[i] = STORAGE_Register(OBJECT_NewString("")); /* default value */
+			a->values[i] = STORAGE_Register(OBJECT_NewString("")); /* default value */
 		/* otherwise */
 		else
 			/* add int */
-			((arrayObject*)obj->value)->values[i] = STORAGE_Register(OBJECT_NewInt(0)); /* default value */
+			a->values[i] = OBJECT_NewInt(0); /* default value */
 	}
 	/* assign array size */
 	((arrayObject*)obj->value)->size = size;
+	((arrayObject*)obj->value)->cap = size;
 	/* lastly return the value */
 	return obj;
 }
 
+object *OBJECT_NewVector() {
+	/* create new object */
+	object *obj = OBJECT_NewObject(OBJECT_VECTOR);
+	if (obj == NULL) /* memory allocation wasn't successful */
+		return NULL;
+	/* empty array without a type; the buffer is made by the first push */
+	arrayObject *a = MEMORY_SlabMalloc(arrayObject);
+	if (a == NULL) {
+		MEMORY_SlabFree(obj, object);
+		return NULL;
+	}
+	a->array_type = OBJECT_NONE;
+	a->values = NULL;
+	a->ints = NULL;
+	a->chars = NULL;
+	a->size = 0;
+	a->cap = 0;
+	obj->value = (void*)a;
+	return obj;
+}
+
+void OBJECT_VectorReserve(arrayObject *o, int cap) {
+	/* already has room */
+	if (cap <= o->cap) return;
+	/* grow the buffer for the type; without a type there is no buffer yet */
+	if (o->array_type == OBJECT_INT)
+		o->ints = (int32_t*)realloc(o->ints, sizeof(int32_t) * cap);
+	else if (o->array_type == OBJECT_CHAR)
+		o->chars = (char*)realloc(o->chars, sizeof(char) * cap);
+	else if (o->array_type != OBJECT_NONE)
+		o->values = (object**)realloc(o->values, sizeof(object*) * cap);
+	o->cap = cap;
+}
+
+int OBJECT_VectorPush(arrayObject *o, object *value) {
+	/* the first value decides the type */
+	if (o->array_type == OBJECT_NONE) {
+		int cap = o->cap > 8 ? o->cap : 8;
+		o->array_type = OBJECT_TypeOf(value);
+		o->cap = 0;
+		OBJECT_VectorReserve(o, cap);
+	}
+	/* out of room; doubling keeps pushing linear */
+	else if (o->size == o->cap)
+		OBJECT_VectorReserve(o, o->cap * 2);
+	/* set the value past the end */
+	if (!OBJECT_SetArrayItem(o, o->size, value)) return 0;
+	o->size++;
+	return 1; /* success */
+}
+
 object *OBJECT_NewString(const char *s) {
+	/* create a string object */
+	return OBJECT_NewStringLen(s, strlen(s));
+}
+
+object *OBJECT_NewStringLen(const char *s, int len) {
 	/* create a string object */
 	object *obj = OBJECT_NewObject(OBJECT_STRING);
 
 	if (!obj || obj == NULL)
 		return NULL; /* unsuccessful allocation */
 
+	/* header and chars in one block */
+	stringObject *str = (stringObject*)malloc(sizeof(stringObject) + len);
+	if (str == NULL) {
+		MEMORY_SlabFree(obj, object);
+		return NULL;
+	}
 	/* copy string */
-	char *sb = (char*)malloc(strlen(s)+1);
-	strcpy(sb, s);
-	s = sb; /* 's' will be freed eventually */
-	obj->value = (void*)s; /* assign the value of the string */
+	str->len = len;
+	str->cap = len;
+	str->hash = 0;
+	if (s != NULL) memcpy(str->chars, s, len);
+	str->chars[len] = '\0';
+	obj->value = (void*)str; /* assign the value of the string */
 	return obj;
 }
 
+void OBJECT_StringAppend(object *o, const char *s, int len) {
+	stringObject *str = OBJECT_String(o);
+	/* make room, doubling so that appending many times is linear */
+	if (str->len + len > str->cap) {
+		int cap = str->cap * 2 > str->len + len ? str->cap * 2 : str->len + len;
+		if (cap < 16) cap = 16;
+		/* chars in the scratch region are moved within it; the old ones go when it is released */
+		if (OBJECT_IsScratch(o)) {
+			stringObject *old = str;
+			str = (stringObject*)ARENA_Alloc(STORAGE_Scratch, sizeof(stringObject) + cap);
+			memcpy(str, old, sizeof(stringObject) + old->len);
+		}
+		else
+			str = (stringObject*)realloc(str, sizeof(stringObject) + cap);
+		/* the new room is empty, and chars[cap] is always a null term */
+		memset(str->chars + str->len, 0, cap + 1 - str->len);
+		str->cap = cap;
+		o->value = (void*)str;
+	}
+	/* add the chars */
+	memcpy(str->chars + str->len, s, len);
+	str->len += len;
+	str->chars[str->len] = '\0';
+	str->hash = 0; /* chars changed */
+}
+
+unsigned int OBJECT_StringHash(object *o) {
+	stringObject *str = OBJECT_String(o);
+	/* work it out once; 0 means not known, so it is never used as a hash */
+	if (str->hash == 0) {
+		str->hash = NAMES_Hash(str->chars);
+		if (str->hash == 0) str->hash = 1;
+	}
+	return str->hash;
+}
+
+object *OBJECT_Literal(node *n) {
+	/* already made; d holds its index + 1 */
+	if (n->d > 0) return OBJECT_Literals[n->d - 1];
+	/* make the string */
+	object *o = OBJECT_NewString(n->tokens[0]->value);
+	if (o == NULL) return NULL;
+	o->flags |= OBJECT_SHARED;
+	OBJECT_StringHash(o); /* known up front, since comparisons can use it */
+	/* check the capacity */
+	if (OBJECT_LiteralsSz >= OBJECT_LiteralsCap) {
+		/* realloc list */
+		OBJECT_LiteralsCap = OBJECT_LiteralsCap ? OBJECT_LiteralsCap * 2 : 64;
+		OBJECT_Literals = (object**)realloc(OBJECT_Literals, sizeof(object*) * OBJECT_LiteralsCap);
+	}
+	/* add the literal; the set lets an address be checked for it without a scan */
+	OBJECT_Literals[OBJECT_LiteralsSz++] = o;
+	STORAGE_SetAdd(&STORAGE_SharedPointers, o);
+	n->d = OBJECT_LiteralsSz;
+	return o;
+}
+
+void OBJECT_FreeLiterals() {
+	/* no longer shared, so they can be freed */
+	for (int k = 0; k < OBJECT_LiteralsSz; k++) {
+		OBJECT_Literals[k]->flags &= ~OBJECT_SHARED;
+		OBJECT_FreeObject(OBJECT_Literals[k]);
+	}
+	/* free the list */
+	free(OBJECT_Literals);
+	OBJECT_Literals = NULL;
+	OBJECT_LiteralsSz = 0;
+	OBJECT_LiteralsCap = 0;
+}
+
 object *OBJECT_NewInt(int i) {
-	/* create an int object */
+	/* most ints are kept in the pointer and need no allocation */
+	if (OBJECT_FitsImmediate(i))
+		return OBJECT_Immediate(i, OBJECT_TAG_INT);
+
+	/* otherwise, create an int object */
 	object *obj = OBJECT_NewObject(OBJECT_INT);
 
 	if (!obj || obj == NULL)
 		return NULL; /* failed allocation */
 
 	/* int is most likely to be stack allocated, so we create a new variable with value of int instead */
-	int *val = MEMORY_Malloc(int);
+	int *val = MEMORY_SlabMalloc(int);
 	if (!val || val == NULL) /* failed allocation */
 		return NULL;
 
@@ -122,24 +303,86 @@ object *OBJECT_NewInt(int i) {
 	return obj;
 }
 
-object *OBJECT_NewChar(char c) {
-	/* create an int object */
-	object *obj = OBJECT_NewInt((int)c);
+object *OBJECT_TempInt(int i) {
+	/* most ints are kept in the pointer and need no allocation */
+	if (OBJECT_FitsImmediate(i))
+		return OBJECT_Immediate(i, OBJECT_TAG_INT);
+
+	/* header and value in one allocation */
+	object *obj = (object*)ARENA_Alloc(STORAGE_Scratch, sizeof(object) + sizeof(int));
+	if (obj == NULL)
+		return NULL; /* failed allocation */
+	obj->type = OBJECT_INT;
+	obj->flags = OBJECT_SCRATCH;
+	obj->value = (void*)(obj + 1);
+	*(int*)obj->value = i;
+	return obj;
+}
+
+object *OBJECT_TempString(int len) {
+	/* header, string and chars in one allocation */
+	object *obj = (object*)ARENA_Alloc(STORAGE_Scratch, sizeof(object) + sizeof(stringObject) + len);
+	if (obj == NULL)
+		return NULL; /* failed allocation */
+	obj->type = OBJECT_STRING;
+	obj->flags = OBJECT_SCRATCH;
+	stringObject *str = (stringObject*)(obj + 1);
+	str->len = len;
+	str->cap = len;
+	str->hash = 0;
+	str->chars[len] = '\0';
+	obj->value = (void*)str;
+	return obj;
+}
+
+object *OBJECT_NewFloat(float f) {
+	/* create a float object */
+	object *obj = OBJECT_NewObject(OBJECT_FLOAT);
 
 	if (!obj || obj == NULL)
 		return NULL; /* failed allocation */
 
-	obj->type = OBJECT_CHAR; /* indicate char */
-	return obj; /* return the object */
+	/* floats are always allocated */
+	float *val = MEMORY_SlabMalloc(float);
+	if (!val || val == NULL) /* failed allocation */
+		return NULL;
+
+	*val = f;
+
+	obj->value = (void*)val; /* assign the value of the float */
+	return obj;
+}
+
+object *OBJECT_NewChar(char c) {
+	/* chars always fit in the pointer */
+	return OBJECT_Immediate((int)c, OBJECT_TAG_CHAR);
 }
 
 void OBJECT_FreeObject(object *o) {
-	if (o->type != OBJECT_ARRAY && o->type != OBJECT_FUNCTION) {
+	/* ints and chars kept in the pointer have nothing to free, shared literals belong to their node
+	and temporaries to the scratch region */
+	if (OBJECT_IsImmediate(o) || (o->flags & (OBJECT_SHARED | OBJECT_SCRATCH)))
+		return;
+	if (o->type == OBJECT_INSTANCE) { /* instance */
+		OBJECT_FreeInstance((instance*)o->value); /* free the values of the instance */
+		MEMORY_SlabFree(o->value, instance); /* free the actual instance */
+	}
+	else if (o->type == OBJECT_MAP) { /* map */
+		OBJECT_FreeMap((mapObject*)o->value); /* free the keys and values of the map */
+		MEMORY_SlabFree(o->value, mapObject); /* free the actual map */
+	}
+	else if (o->type == OBJECT_INT) { /* int too big to be kept in the pointer */
+		MEMORY_SlabFree(o->value, int);
+	}
+	else if (o->type == OBJECT_FLOAT) { /* float */
+		MEMORY_SlabFree(o->value, float);
+	}
+	else if (o->type != OBJECT_ARRAY && o->type != OBJECT_VECTOR && o->type != OBJECT_FUNCTION) {
 		MEMORY_Free(o->value); /* frees value */
 	}
-	else if (o->type == OBJECT_ARRAY) { /* array */
+	else if (o->type == OBJECT_ARRAY || o->type == OBJECT_VECTOR) { /* array or vector */
 		OBJECT_FreeArray((arrayObject*)o->value); /* free the values of the array */
-		MEMORY_Free(o->value); /* free the actual array */
+		MEMORY_SlabFree(o->value, arrayObject); /* free the actual array */
 	}
 	else if (o->type == OBJECT_STRUCT) { /* struct */
 		OBJECT_FreeStruct((structObject*)o->value);
@@ -155,19 +398,176 @@ void OBJECT_FreeObject(object *o) {
 		free(f->arg_names);
 		free(f->arg_types);
 		free(f->func_name);
+		/* free compiled body */
+		if (f->code != NULL) COMPILER_FreeChunk(f->code);
 		/* free body node (because it has been copied from parser won't be freed automatically) */
-		NODE_FreeCopyNode(f->body_node);
+		if (f->body_arena != NULL) ARENA_FreeArena(f->body_arena);
 	}
-	MEMORY_Free(o); /* free the object from memory */
+	MEMORY_SlabFree(o, object); /* free the object from memory */
 }
 
 void OBJECT_FreeArray(arrayObject *o) {
+	/* int or char buffer */
+	if (o->values == NULL) {
+		free(o->ints);
+		free(o->chars);
+		return;
+	}
 	/* loop through values and free them */
 	for (int i = 0; i < o->size; i++)
 		if (!STORAGE_Find(o->values[i])) OBJECT_FreeObject(o->values[i]); /* free an object */
 	MEMORY_Free(o->values); /* free the actual array */
 }
 
+object *OBJECT_GetArrayItem(arrayObject *o, int idx) {
+	/* int */
+	if (o->ints != NULL)
+		return OBJECT_NewInt(o->ints[idx]);
+	/* char */
+	if (o->chars != NULL)
+		return OBJECT_NewChar(o->chars[idx]);
+	/* object */
+	return o->values[idx];
+}
+
+int OBJECT_SetArrayItem(arrayObject *o, int idx, object *value) {
+	int type = OBJECT_TypeOf(value);
+	/* int array takes ints and chars */
+	if (o->ints != NULL) {
+		if (type != OBJECT_INT && type != OBJECT_CHAR) return 0;
+		o->ints[idx] = OBJECT_IntValue(value);
+	}
+	/* char array takes chars, ints and the first char of a string */
+	else if (o->chars != NULL) {
+		if (type == OBJECT_STRING) o->chars[idx] = OBJECT_StringChars(value)[0];
+		else if (type == OBJECT_INT || type == OBJECT_CHAR) o->chars[idx] = OBJECT_CharValue(value);
+		else return 0;
+	}
+	/* object of the array's type (any type for the keys of a map), must be registered first */
+	else {
+		if (type != o->array_type && o->array_type != OBJECT_ANY) return 0;
+		o->values[idx] = value;
+	}
+	return 1; /* success */
+}
+
+void OBJECT_FreeInstance(instance *o) {
+	/* values are always registered, so only the list is freed */
+	MEMORY_Free(o->values);
+}
+
+object *OBJECT_NewMap() {
+	/* create new object */
+	object *obj = OBJECT_NewObject(OBJECT_MAP);
+	if (obj == NULL) /* memory allocation wasn't successful */
+		return NULL;
+	/* empty table */
+	mapObject *m = MEMORY_SlabMalloc(mapObject);
+	if (m == NULL) {
+		MEMORY_SlabFree(obj, object);
+		return NULL;
+	}
+	m->cap = 8;
+	m->sz = 0;
+	m->used = 0;
+	m->entries = (mapEntry*)calloc(m->cap, sizeof(mapEntry));
+	obj->value = (void*)m;
+	return obj;
+}
+
+int OBJECT_IsKey(object *key) {
+	return OBJECT_TypeOf(key) == OBJECT_STRING || OBJECT_TypeOf(key) == OBJECT_INT;
+}
+
+unsigned int OBJECT_MapHash(object *key) {
+	/* strings keep their hash, which is never 0 */
+	if (OBJECT_TypeOf(key) == OBJECT_STRING)
+		return OBJECT_StringHash(key);
+	/* spread the bits of ints so that close keys don't share slots */
+	unsigned int h = (unsigned int)OBJECT_IntValue(key) * 2654435761u;
+	return h != 0 ? h : 1;
+}
+
+mapEntry *OBJECT_MapFind(mapObject *o, object *key) {
+	unsigned int h = OBJECT_MapHash(key);
+	int type = OBJECT_TypeOf(key);
+	/* look from the slot of the hash until an empty slot */
+	for (int k = h & (o->cap - 1); o->entries[k].hash != 0; k = (k + 1) & (o->cap - 1)) {
+		mapEntry *e = &o->entries[k];
+		/* removed, or a different key */
+		if (e->key == NULL || e->hash != h || OBJECT_TypeOf(e->key) != type) continue;
+		if (type == OBJECT_INT ? OBJECT_IntValue(e->key) == OBJECT_IntValue(key) : OBJECT_StringEquals(e->key, key))
+			return e;
+	}
+	/* not found */
+	return NULL;
+}
+
+void OBJECT_MapSet(mapObject *o, object *key, object *value) {
+	/* key is already there */
+	mapEntry *e = OBJECT_MapFind(o, key);
+	if (e != NULL) {
+		e->value = value;
+		return;
+	}
+	/* keep at most 3/4 of the slots used, so that looking for a key stays short */
+	if ((o->used + 1) * 4 > o->cap * 3) {
+		/* new table with room for twice the keys; removed entries are dropped */
+		int cap = 8;
+		while ((o->sz + 1) * 2 > cap) cap *= 2;
+		mapEntry *old = o->entries;
+		int old_cap = o->cap;
+		o->entries = (mapEntry*)calloc(cap, sizeof(mapEntry));
+		o->cap = cap;
+		o->used = o->sz;
+		for (int k = 0; k < old_cap; k++) {
+			if (old[k].key == NULL) continue;
+			int j = old[k].hash & (cap - 1);
+			while (o->entries[j].hash != 0) j = (j + 1) & (cap - 1);
+			o->entries[j] = old[k];
+		}
+		free(old);
+	}
+	/* first removed or empty slot */
+	unsigned int h = OBJECT_MapHash(key);
+	int k = h & (o->cap - 1);
+	while (o->entries[k].key != NULL) k = (k + 1) & (o->cap - 1);
+	if (o->entries[k].hash == 0) o->used++;
+	/* the map gets its own copy of the key */
+	e = &o->entries[k];
+	e->hash = h;
+	if (OBJECT_TypeOf(key) == OBJECT_STRING) {
+		e->key = OBJECT_NewStringLen(OBJECT_StringChars(key), OBJECT_StringLen(key));
+		OBJECT_String(e->key)->hash = h;
+	}
+	else
+		e->key = OBJECT_NewInt(OBJECT_IntValue(key));
+	e->value = value;
+	o->sz++;
+}
+
+int OBJECT_MapRemove(mapObject *o, object *key) {
+	/* not there */
+	mapEntry *e = OBJECT_MapFind(o, key);
+	if (e == NULL) return 0;
+	/* keep the hash, so keys after it are still found */
+	OBJECT_FreeObject(e->key);
+	e->key = NULL;
+	e->value = NULL;
+	o->sz--;
+	return 1;
+}
+
+void OBJECT_FreeMap(mapObject *o) {
+	/* keys belong to the map; values are freed unless they are registered */
+	for (int k = 0; k < o->cap; k++) {
+		if (o->entries[k].key == NULL) continue;
+		OBJECT_FreeObject(o->entries[k].key);
+		if (!STORAGE_Find(o->entries[k].value)) OBJECT_FreeObject(o->entries[k].value);
+	}
+	free(o->entries);
+}
+
 void OBJECT_FreeStruct(structObject *o) {
 	/* loop through names and free them */
 	for (int i = 0; i < o->n_of_vals; i++)
@@ -181,7 +581,7 @@ void OBJECT_FreeStruct(structObject *o) {
 int OBJECT_StringLength(arrayObject *o) {
 	/* loop until we reach the null term char */
 	int i = 0;
-	while ((char)*(int*)(o->values[i]) != '\0') {
+	while (i < o->size && o->chars[i] != '\0') {
 		/* advance i */
 		i++;
 	}
@@ -190,37 +590,30 @@ int OBJECT_StringLength(arrayObject *o) {
 
 object *OBJECT_AddedTo(object *self, object *other) {
 	/* check for int */
-	if (self->type == OBJECT_INT) {
+	if (OBJECT_TypeOf(self) == OBJECT_INT) {
 		/* illegal operation */
-		if (other->type != OBJECT_INT)
+		if (OBJECT_TypeOf(other) != OBJECT_INT)
 			/* return */
 			return NULL;
 		/* create new object */
-		object *o = OBJECT_NewInt(*(int*)(self->value) + *(int*)(other->value));
+		object *o = OBJECT_TempInt(OBJECT_IntValue(self) + OBJECT_IntValue(other));
 		/* return object */
 		return o;
 	}
 	/* check for string */
-	else if (self->type == OBJECT_STRING) {
+	else if (OBJECT_TypeOf(self) == OBJECT_STRING) {
 		/* illegal operation */
-		if (other->type != OBJECT_STRING)
+		if (OBJECT_TypeOf(other) != OBJECT_STRING)
 			/* return */
 			return NULL;
-		/* create new string buffer */
-		char *s = (char*)malloc(1024);
-		/* copy first string */
-		strcpy(s, (char*)self->value);
-		/* concat second string */
-		strcat(s, (char*)other->value);
-		/* create new object */
-		object *o = OBJECT_NewString(s);
+		/* create new object with room for both strings */
+		object *o = OBJECT_TempString(OBJECT_StringLen(self) + OBJECT_StringLen(other));
 		/* failed allocation */
-		if (o == NULL) {
-			/* free string value */
-			free(s);
-			/* return null */
+		if (o == NULL)
 			return NULL;
-		}
+		/* concat the strings */
+		memcpy(OBJECT_StringChars(o), OBJECT_StringChars(self), OBJECT_StringLen(self));
+		memcpy(OBJECT_StringChars(o) + OBJECT_StringLen(self), OBJECT_StringChars(other), OBJECT_StringLen(other));
 		/* return object */
 		return o;
 	}
@@ -230,13 +623,13 @@ object *OBJECT_AddedTo(object *self, object *other) {
 
 object *OBJECT_SubbedBy(object *self, object *other) {
 	/* check for int */
-	if (self->type == OBJECT_INT) {
+	if (OBJECT_TypeOf(self) == OBJECT_INT) {
 		/* illegal operation */
-		if (other->type != OBJECT_INT)
+		if (OBJECT_TypeOf(other) != OBJECT_INT)
 			/* return null */
 			return NULL;
 		/* create new object */
-		object *o = OBJECT_NewInt(*(int*)(self->value) - *(int*)(other->value));
+		object *o = OBJECT_TempInt(OBJECT_IntValue(self) - OBJECT_IntValue(other));
 		/* return object */
 		return o;
 	}
@@ -246,13 +639,13 @@ object *OBJECT_SubbedBy(object *self, object *other) {
 
 object *OBJECT_MultedBy(object *self, object *other) {
 	/* check for int */
-	if (self->type == OBJECT_INT) {
+	if (OBJECT_TypeOf(self) == OBJECT_INT) {
 		/* illegal operation */
-		if (other->type != OBJECT_INT)
+		if (OBJECT_TypeOf(other) != OBJECT_INT)
 			/* return null */
 			return NULL;
 		/* create new object */
-		object *o = OBJECT_NewInt(*(int*)(self->value) * *(int*)(other->value));
+		object *o = OBJECT_TempInt(OBJECT_IntValue(self) * OBJECT_IntValue(other));
 		return o; /* return object */
 	}
 
@@ -262,13 +655,13 @@ object *OBJECT_MultedBy(object *self, object *other) {
 
 object *OBJECT_DivedBy(object *self, object *other) {
 	/* check for int */
-	if (self->type == OBJECT_INT) {
+	if (OBJECT_TypeOf(self) == OBJECT_INT) {
 		/* illegal operation */
-		if (other->type != OBJECT_INT)
+		if (OBJECT_TypeOf(other) != OBJECT_INT)
 			/* return null */
 			return NULL;
 		/* create new object */
-		object *o = OBJECT_NewInt(*(int*)(self->value) / *(int*)(other->value));
+		object *o = OBJECT_TempInt(OBJECT_IntValue(self) / OBJECT_IntValue(other));
 		return o; /* return object */
 	}
 
@@ -278,99 +671,103 @@ object *OBJECT_DivedBy(object *self, object *other) {
 
 object *OBJECT_ModdedBy(object *self, object *other) {
 	/* check for int */
-	if (self->type == OBJECT_INT) {
+	if (OBJECT_TypeOf(self) == OBJECT_INT) {
 		/* illegal operation */
-		if (other->type != OBJECT_INT)
+		if (OBJECT_TypeOf(other) != OBJECT_INT)
 			return NULL; /* exit */
 		/* return object */
-		return OBJECT_NewInt(*(int*)(self->value) % *(int*)(other->value));
+		return OBJECT_TempInt(OBJECT_IntValue(self) % OBJECT_IntValue(other));
 	}
 	return NULL;
 }
 
-object *OBJECT_IsEqualTo(object *self, object *other) {
-	/* check for int */
-	if (self->type == OBJECT_INT) {
-		/* illegal operation */
-		if (other->type != OBJECT_INT)
-			/* return null */
-			return NULL;
-		/* create new object */
-		return OBJECT_NewInt((int)(*(int*)(self->value) == *(int*)(other->value)));
+int OBJECT_Compare(object *self, object *other, int cmp) {
+	int diff; /* <0, 0 or >0, like strcmp */
+	/* ints and chars, which can't be compared with each other */
+	if ((OBJECT_TypeOf(self) == OBJECT_INT || OBJECT_TypeOf(self) == OBJECT_CHAR) && OBJECT_TypeOf(other) == OBJECT_TypeOf(self)) {
+		int a = OBJECT_IntValue(self), b = OBJECT_IntValue(other);
+		diff = (a > b) - (a < b);
 	}
-	/* check for char */
-	if (self->type == OBJECT_CHAR) {
-		/* illegal operation */
-		if (other->type != OBJECT_CHAR)
-			/* return null */
-			return NULL;
-		/* create new object */
-		return OBJECT_NewInt((int)(*(char*)(self->value) == *(char*)(other->value)));
-	}
-	/* check for string */
-	if (self->type == OBJECT_STRING) {
-		/* illegal operation */
-		if (other->type != OBJECT_STRING)
-			/* return null */
-			return NULL;
-		/* create new object */
-		return OBJECT_NewInt((int)(!strcmp((char*)self->value, (char*)other->value)));
+	/* strings */
+	else if (OBJECT_TypeOf(self) == OBJECT_STRING && OBJECT_TypeOf(other) == OBJECT_STRING) {
+		/* equality can skip comparing the chars */
+		if (cmp == OBJECT_CMP_EQ) return OBJECT_StringEquals(self, other);
+		if (cmp == OBJECT_CMP_NE) return !OBJECT_StringEquals(self, other);
+		/* otherwise, in order of their chars and then their lengths */
+		int la = OBJECT_StringLen(self), lb = OBJECT_StringLen(other);
+		diff = memcmp(OBJECT_StringChars(self), OBJECT_StringChars(other), la < lb ? la : lb);
+		if (diff == 0) diff = la - lb;
 	}
-	/* return null */
-	return NULL;
+	/* illegal operation */
+	else
+		return -1;
+	/* truth value */
+	if (cmp == OBJECT_CMP_EQ) return diff == 0;
+	if (cmp == OBJECT_CMP_NE) return diff != 0;
+	if (cmp == OBJECT_CMP_LT) return diff < 0;
+	return diff > 0;
+}
+
+object *OBJECT_IsEqualTo(object *self, object *other) {
+	/* compare */
+	int r = OBJECT_Compare(self, other, OBJECT_CMP_EQ);
+	/* illegal operation, or new int */
+	return r < 0 ? NULL : OBJECT_NewInt(r);
+}
+
+int OBJECT_StringEquals(object *self, object *other) {
+	stringObject *a = OBJECT_String(self), *b = OBJECT_String(other);
+	/* different lengths, or different hashes if both are known */
+	if (a->len != b->len || (a->hash && b->hash && a->hash != b->hash))
+		return 0;
+	/* compare the chars */
+	return !memcmp(a->chars, b->chars, a->len);
 }
 
 object *OBJECT_IsNotEqualTo(object *self, object *other) {
-	/* check for int */
-	if (self->type == OBJECT_INT) {
-		/* illegal operation */
-		if (other->type != OBJECT_INT)
-			/* return null */
-			return NULL;
-		/* create new object */
-		return OBJECT_NewInt((int)(*(int*)(self->value) != *(int*)(other->value)));
-	}
-	/* check for string */
-	if (self->type == OBJECT_STRING) {
-		/* illegal operation */
-		if (other->type != OBJECT_STRING)
-			/* return null */
-			return NULL;
-		/* create new object */
-		return OBJECT_NewInt((int)(!!strcmp((char*)self->value, (char*)other->value)));
-	}
-	/* return null */
-	return NULL;
+	/* compare */
+	int r = OBJECT_Compare(self, other, OBJECT_CMP_NE);
+	/* illegal operation, or new int */
+	return r < 0 ? NULL : OBJECT_NewInt(r);
 }
 
 object *OBJECT_IsLessThan(object *self, object *other) {
-	/* unimplemented */
-	return NULL;
+	/* compare */
+	int r = OBJECT_Compare(self, other, OBJECT_CMP_LT);
+	/* illegal operation, or new int */
+	return r < 0 ? NULL : OBJECT_NewInt(r);
 }
 
 object *OBJECT_IsGreaterThan(object *self, object *other) {
-	/* unimplemented */
-	return NULL;
+	/* compare */
+	int r = OBJECT_Compare(self, other, OBJECT_CMP_GT);
+	/* illegal operation, or new int */
+	return r < 0 ? NULL : OBJECT_NewInt(r);
 }
 
-object *OBJECT_IsTrue(object *self) {
+int OBJECT_Truth(object *self) {
 	/* integer */
-	if (self->type == OBJECT_INT) {
+	if (OBJECT_TypeOf(self) == OBJECT_INT) {
 		/* != 0 */
-		return OBJECT_NewInt((int)(*(int*)self->value != 0));
+		return OBJECT_IntValue(self) != 0;
 	}
 	/* string */
-	if (self->type == OBJECT_STRING) {
+	if (OBJECT_TypeOf(self) == OBJECT_STRING) {
 		/* != "" */
-		return OBJECT_NewInt((int)!strcmp((char*)self->value, ""));
+		return OBJECT_StringLen(self) == 0;
 	}
 	/* char */
-	if (self->type == OBJECT_CHAR) {
+	if (OBJECT_TypeOf(self) == OBJECT_CHAR) {
 		/* != 0 */
-		return OBJECT_NewInt((int)(*(char*)self->value != (char)0));
+		return OBJECT_CharValue(self) != (char)0;
 	}
 	/* default value */
-	return OBJECT_NewInt(1);
+	return 1;
+}
+
+object *OBJECT_IsTrue(object *self) {
+	/* new int */
+	return OBJECT_NewInt(OBJECT_Truth(self));
 }
 
 object *OBJECT_NewStruct(char *name, uint8_t *val_types, char **val_names, int n_of_vals) {
@@ -400,7 +797,7 @@ object *OBJECT_NewStruct(char *name, uint8_t *val_types, char **val_names, int n
 
 object *OBJECT_NewInstance(structObject *st) {
 	/* allocate new instance */
-	instance *i = MEMORY_Malloc(instance);
+	instance *i = MEMORY_SlabMalloc(instance);
 	/* bad memory */
 	if (i == NULL)
 		return NULL;
@@ -410,7 +807,7 @@ object *OBJECT_NewInstance(structObject *st) {
 	object *o = OBJECT_NewObject(OBJECT_INSTANCE);
 	/* bad memory */
 	if (o == NULL) {
-		MEMORY_Free(i); /* free */
+		MEMORY_SlabFree(i, instance); /* free */
 		return NULL;
 	}
 	o->value = (void*)i;
@@ -419,10 +816,22 @@ object *OBJECT_NewInstance(structObject *st) {
 	/* bad memory */
 	if (i->values == NULL) {
 		/* free */
-		MEMORY_Free(i);
-		MEMORY_Free(o);
+		MEMORY_SlabFree(i, instance);
+		MEMORY_SlabFree(o, object);
 		return NULL;
 	}
+	/* fill in default values */
+	for (int k = 0; k < st->n_of_vals; k++) {
+		/* check for string */
+		if (st->val_types[k] == OBJECT_STRING)
+			i->values[k] = STORAGE_Register(OBJECT_NewString(""));
+		/* check for char */
+		else if (st->val_types[k] == OBJECT_CHAR)
+			i->values[k] = STORAGE_Register(OBJECT_NewChar(0));
+		/* otherwise */
+		else
+			i->values[k] = STORAGE_Register(OBJECT_NewInt(0));
+	}
 	/* return object */
 	return o;
 }
@@ -16,45 +16,49 @@ extern "C" {
 
 object *OBJECTIO_PrintObject(object *o) {
 	/* integer */
-	if (o->type == OBJECT_INT)
+	if (OBJECT_TypeOf(o) == OBJECT_INT)
 		/* print integer */
-		printf("%d\n", *(int*)o->value);
+		printf("%d\n", OBJECT_IntValue(o));
 	/* float */
-	if (o->type == OBJECT_FLOAT)
+	if (OBJECT_TypeOf(o) == OBJECT_FLOAT)
 		/* print float */
 		printf("%f\n", *(float*)o->value);
 	/* char */
-	if (o->type == OBJECT_CHAR)
+	if (OBJECT_TypeOf(o) == OBJECT_CHAR)
 		/* print char */
-		printf("%c\n", *(char*)o->value);
+		printf("%c\n", OBJECT_CharValue(o));
 	/* string */
-	if (o->type == OBJECT_STRING)
+	if (OBJECT_TypeOf(o) == OBJECT_STRING)
 		/* print string */
-		printf("%s\n", (char*)o->value);
+		printf("%s\n", OBJECT_StringChars(o));
 	/* function */
-	if (o->type == OBJECT_FUNCTION) {
+	if (OBJECT_TypeOf(o) == OBJECT_FUNCTION) {
 		/* print function */
 		printf("<function \'%s\'>\n", ((function*)o->value)->func_name);
 	}
 	/* array */
-	if (o->type == OBJECT_ARRAY)
+	if (OBJECT_TypeOf(o) == OBJECT_ARRAY)
 		/* string (aka char array) */
 		if (((arrayObject*)o->value)->array_type == OBJECT_CHAR) { /* char array / string */
-			/* loop through chars */
-			for (int i = 0; i < OBJECT_StringLength((arrayObject*)o->value); i++)
-				/* print the char */
-				printf("%c", (char)*(int*)((arrayObject*)o->value)->values[i]->value);
-			/* print newline */
-			printf("\n");
+			/* print the chars up to the null term char */
+			printf("%.*s\n", OBJECT_StringLength((arrayObject*)o->value), ((arrayObject*)o->value)->chars);
 		}
 	/* struct */
-	if (o->type == OBJECT_STRUCT)
+	if (OBJECT_TypeOf(o) == OBJECT_STRUCT)
 		/* struct */
 		printf("<struct \'%s\'>\n", ((structObject*)o->value)->struct_name);
 	/* instance */
-	if (o->type == OBJECT_INSTANCE)
+	if (OBJECT_TypeOf(o) == OBJECT_INSTANCE)
 		/* instance */
 		printf("<instance of struct \'%s\'>\n", ((instance*)o->value)->st->struct_name);
+	/* vector */
+	if (OBJECT_TypeOf(o) == OBJECT_VECTOR)
+		/* number of values */
+		printf("<vector of %d values>\n", ((arrayObject*)o->value)->size);
+	/* map */
+	if (OBJECT_TypeOf(o) == OBJECT_MAP)
+		/* number of keys */
+		printf("<map of %d keys>\n", ((mapObject*)o->value)->sz);
 
 	/* return the object */
 	return o;
@@ -0,0 +1,191 @@
+/* see strlib.h for documentation */
+#include "strlib.h" /* our header */
+#include "object.h" /* objects */
+#include "storage.h" /* registering results */
+#include "names.h" /* assigning the functions */
+
+#include <stdlib.h> /* NULL */
+#include <string.h> /* memchr, memcmp, memcpy, memset */
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+void STRLIB_Init() {
+	/* argument names and types of each function */
+	const char *alloc_names[] = {"bufsz"};
+	const uint8_t alloc_types[] = {OBJECT_INT};
+	const char *len_names[] = {"strbuf"};
+	const uint8_t len_types[] = {OBJECT_INT};
+	const char *cpy_names[] = {"src", "dst"};
+	const uint8_t cpy_types[] = {OBJECT_INT, OBJECT_STRING};
+	const char *fill_names[] = {"src", "ch"};
+	const uint8_t fill_types[] = {OBJECT_INT, OBJECT_STRING};
+	const char *fmt_names[] = {"src", "asrc"};
+	const uint8_t fmt_types[] = {OBJECT_INT, OBJECT_STRING};
+	const char *find_names[] = {"s", "sub"};
+	const uint8_t find_types[] = {OBJECT_STRING, OBJECT_STRING};
+	const char *sub_names[] = {"s", "start", "len"};
+	const uint8_t sub_types[] = {OBJECT_STRING, OBJECT_INT, OBJECT_INT};
+	const char *split_names[] = {"s", "sep", "idx"};
+	const uint8_t split_types[] = {OBJECT_STRING, OBJECT_STRING, OBJECT_INT};
+	/* assign the functions */
+	NAMES_Assign((char*)"stralloc", STORAGE_Register(OBJECT_NewNative("stralloc", OBJECT_INT, alloc_names, alloc_types, 1, STRLIB_Alloc)));
+	NAMES_Assign((char*)"strlen", STORAGE_Register(OBJECT_NewNative("strlen", OBJECT_INT, len_names, len_types, 1, STRLIB_Len)));
+	NAMES_Assign((char*)"strcpy", STORAGE_Register(OBJECT_NewNative("strcpy", OBJECT_INT, cpy_names, cpy_types, 2, STRLIB_Cpy)));
+	NAMES_Assign((char*)"strfill", STORAGE_Register(OBJECT_NewNative("strfill", OBJECT_INT, fill_names, fill_types, 2, STRLIB_Fill)));
+	NAMES_Assign((char*)"strfmt", STORAGE_Register(OBJECT_NewNative("strfmt", OBJECT_INT, fmt_names, fmt_types, 2, STRLIB_Fmt)));
+	NAMES_Assign((char*)"strfind", STORAGE_Register(OBJECT_NewNative("strfind", OBJECT_INT, find_names, find_types, 2, STRLIB_Find)));
+	NAMES_Assign((char*)"substr", STORAGE_Register(OBJECT_NewNative("substr", OBJECT_STRING, sub_names, sub_types, 3, STRLIB_Sub)));
+	NAMES_Assign((char*)"strsplit", STORAGE_Register(OBJECT_NewNative("strsplit", OBJECT_STRING, split_names, split_types, 3, STRLIB_Split)));
+}
+
+object *STRLIB_Deref(object *adr, const char **err) {
+	object *o = (object*)OBJECT_IntValue(adr);
+	/* registered objects and shared literals are the only strings an address can point to */
+	if (o != NULL && !OBJECT_IsImmediate(o) && (STORAGE_Find(o) || STORAGE_FindShared(o)) && o->type == OBJECT_STRING)
+		return o;
+	/* anything else */
+	*err = "Expected the address of a string";
+	return NULL;
+}
+
+int STRLIB_IndexOf(const char *s, int len, const char *sub, int sublen, int from) {
+	/* empty strings are found straight away */
+	if (sublen == 0) return from <= len ? from : -1;
+	/* jump to each place the first char appears and compare the rest */
+	const char *p = s + from;
+	const char *end = s + len - sublen + 1;
+	while (p < end) {
+		p = (const char*)memchr(p, sub[0], end - p);
+		if (p == NULL) return -1;
+		if (!memcmp(p + 1, sub + 1, sublen - 1)) return p - s;
+		p++;
+	}
+	/* not found */
+	return -1;
+}
+
+object *STRLIB_Alloc(object **args, const char **err) {
+	/* spaces; an empty string if the size is negative */
+	int bufsz = OBJECT_IntValue(args[0]);
+	if (bufsz < 0) bufsz = 0;
+	object *o = OBJECT_NewStringLen(NULL, bufsz);
+	if (o == NULL) return NULL;
+	memset(OBJECT_StringChars(o), ' ', bufsz);
+	/* address of the registered string */
+	return OBJECT_NewInt((int)STORAGE_Register(o));
+}
+
+object *STRLIB_Len(object **args, const char **err) {
+	/* string at the address */
+	object *o = STRLIB_Deref(args[0], err);
+	if (o == NULL) return NULL;
+	return OBJECT_NewInt(OBJECT_StringLen(o));
+}
+
+object *STRLIB_Cpy(object **args, const char **err) {
+	/* string at the address */
+	object *o = STRLIB_Deref(args[0], err);
+	if (o == NULL) return NULL;
+	/* literals are copied before they are changed */
+	if (OBJECT_IsShared(o)) o = STORAGE_Register(o);
+	stringObject *str = OBJECT_String(o);
+	int len = OBJECT_StringLen(args[1]);
+	/* must fit in the buffer */
+	if (len > str->cap) {
+		*err = "Index greater than limit of string";
+		return NULL;
+	}
+	/* copy the chars; the length only changes if they reach past the end */
+	memcpy(str->chars, OBJECT_StringChars(args[1]), len);
+	if (len >= str->len) str->len = strlen(str->chars);
+	str->hash = 0; /* chars changed */
+	/* return the address of the buffer */
+	return OBJECT_NewInt((int)o);
+}
+
+object *STRLIB_Fill(object **args, const char **err) {
+	/* string at the address */
+	object *o = STRLIB_Deref(args[0], err);
+	if (o == NULL) return NULL;
+	/* literals are copied before they are changed */
+	if (OBJECT_IsShared(o)) o = STORAGE_Register(o);
+	stringObject *str = OBJECT_String(o);
+	char ch = OBJECT_StringChars(args[1])[0];
+	/* set the chars; filling with the null term of an empty string empties it */
+	memset(str->chars, ch, str->len);
+	if (ch == '\0') str->len = 0;
+	str->hash = 0; /* chars changed */
+	/* return the address of the buffer */
+	return OBJECT_NewInt((int)o);
+}
+
+object *STRLIB_Fmt(object **args, const char **err) {
+	/* string at the address */
+	object *o = STRLIB_Deref(args[0], err);
+	if (o == NULL) return NULL;
+	const char *s = OBJECT_StringChars(o);
+	int len = OBJECT_StringLen(o);
+	object *a = args[1];
+	/* find the last '%'; without one, the value goes in front */
+	int pos = len - 1;
+	while (pos >= 0 && s[pos] != '%') pos--;
+	int before = pos >= 0 ? pos : 0;
+	int after = pos >= 0 ? pos + 1 : 0;
+	/* chars before it, then the value, then the chars after it */
+	object *r = OBJECT_NewStringLen(NULL, before + OBJECT_StringLen(a) + len - after);
+	if (r == NULL) return NULL;
+	char *d = OBJECT_StringChars(r);
+	memcpy(d, s, before);
+	memcpy(d + before, OBJECT_StringChars(a), OBJECT_StringLen(a));
+	memcpy(d + before + OBJECT_StringLen(a), s + after, len - after);
+	/* address of the registered string */
+	return OBJECT_NewInt((int)STORAGE_Register(r));
+}
+
+object *STRLIB_Find(object **args, const char **err) {
+	return OBJECT_NewInt(STRLIB_IndexOf(OBJECT_StringChars(args[0]), OBJECT_StringLen(args[0]),
+		OBJECT_StringChars(args[1]), OBJECT_StringLen(args[1]), 0));
+}
+
+object *STRLIB_Sub(object **args, const char **err) {
+	int len = OBJECT_StringLen(args[0]);
+	int start = OBJECT_IntValue(args[1]);
+	int n = OBJECT_IntValue(args[2]);
+	/* keep the range inside the string */
+	if (start < 0) start = 0;
+	if (start > len) start = len;
+	if (n < 0) n = 0;
+	if (n > len - start) n = len - start;
+	return OBJECT_NewStringLen(OBJECT_StringChars(args[0]) + start, n);
+}
+
+object *STRLIB_Split(object **args, const char **err) {
+	const char *s = OBJECT_StringChars(args[0]);
+	int len = OBJECT_StringLen(args[0]);
+	const char *sep = OBJECT_StringChars(args[1]);
+	int seplen = OBJECT_StringLen(args[1]);
+	int idx = OBJECT_IntValue(args[2]);
+	/* nothing to split at */
+	if (seplen == 0) {
+		*err = "Separator can't be empty";
+		return NULL;
+	}
+	/* skip the pieces before it */
+	int start = 0;
+	for (int k = 0; k < idx && start >= 0; k++) {
+		start = STRLIB_IndexOf(s, len, sep, seplen, start);
+		if (start >= 0) start += seplen;
+	}
+	/* not that many pieces */
+	if (idx < 0 || start < 0) return OBJECT_NewStringLen("", 0);
+	/* up to the next separator or the end */
+	int end = STRLIB_IndexOf(s, len, sep, seplen, start);
+	if (end < 0) end = len;
+	return OBJECT_NewStringLen(s + start, end - start);
+}
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
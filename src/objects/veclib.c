@@ -0,0 +1,94 @@
+/* see veclib.h for documentation */
+#include "veclib.h" /* our header */
+#include "object.h" /* objects */
+#include "storage.h" /* registered values */
+#include "names.h" /* assigning the functions */
+
+#include <stdlib.h> /* NULL */
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+void VECLIB_Init() {
+	/* argument names and types of each function */
+	const char *vec_names[] = {"v", "x"};
+	const uint8_t vec_types[] = {OBJECT_VECTOR, OBJECT_ANY};
+	const char *idx_names[] = {"v", "idx", "x"};
+	const uint8_t idx_types[] = {OBJECT_VECTOR, OBJECT_INT, OBJECT_ANY};
+	const char *cap_names[] = {"v", "cap"};
+	const uint8_t cap_types[] = {OBJECT_VECTOR, OBJECT_INT};
+	/* assign the functions */
+	NAMES_Assign((char*)"vecnew", STORAGE_Register(OBJECT_NewNative("vecnew", OBJECT_VECTOR, NULL, NULL, 0, VECLIB_New)));
+	NAMES_Assign((char*)"vecpush", STORAGE_Register(OBJECT_NewNative("vecpush", OBJECT_INT, vec_names, vec_types, 2, VECLIB_Push)));
+	NAMES_Assign((char*)"vecpop", STORAGE_Register(OBJECT_NewNative("vecpop", OBJECT_ANY, vec_names, vec_types, 1, VECLIB_Pop)));
+	NAMES_Assign((char*)"vecget", STORAGE_Register(OBJECT_NewNative("vecget", OBJECT_ANY, idx_names, idx_types, 2, VECLIB_Get)));
+	NAMES_Assign((char*)"vecset", STORAGE_Register(OBJECT_NewNative("vecset", OBJECT_ANY, idx_names, idx_types, 3, VECLIB_Set)));
+	NAMES_Assign((char*)"veclen", STORAGE_Register(OBJECT_NewNative("veclen", OBJECT_INT, vec_names, vec_types, 1, VECLIB_Len)));
+	NAMES_Assign((char*)"vecreserve", STORAGE_Register(OBJECT_NewNative("vecreserve", OBJECT_INT, cap_names, cap_types, 2, VECLIB_Reserve)));
+}
+
+object *VECLIB_New(object **args, const char **err) {
+	return OBJECT_NewVector();
+}
+
+object *VECLIB_Push(object **args, const char **err) {
+	arrayObject *a = (arrayObject*)args[0]->value;
+	/* arguments are already registered, so objects can be kept as they are */
+	if (!OBJECT_VectorPush(a, args[1])) {
+		*err = "Mismatched Types";
+		return NULL;
+	}
+	return OBJECT_NewInt(a->size);
+}
+
+object *VECLIB_Pop(object **args, const char **err) {
+	arrayObject *a = (arrayObject*)args[0]->value;
+	/* nothing to remove */
+	if (a->size == 0) {
+		*err = "Vector is empty";
+		return NULL;
+	}
+	return OBJECT_GetArrayItem(a, --a->size);
+}
+
+object *VECLIB_Get(object **args, const char **err) {
+	arrayObject *a = (arrayObject*)args[0]->value;
+	int idx = OBJECT_IntValue(args[1]);
+	/* invalid index */
+	if (idx < 0 || idx >= a->size) {
+		*err = "Index greater than limit of array";
+		return NULL;
+	}
+	return OBJECT_GetArrayItem(a, idx);
+}
+
+object *VECLIB_Set(object **args, const char **err) {
+	arrayObject *a = (arrayObject*)args[0]->value;
+	int idx = OBJECT_IntValue(args[1]);
+	/* invalid index */
+	if (idx < 0 || idx >= a->size) {
+		*err = "Index greater than limit of array";
+		return NULL;
+	}
+	/* set the value */
+	if (!OBJECT_SetArrayItem(a, idx, args[2])) {
+		*err = "Mismatched Types";
+		return NULL;
+	}
+	return args[2];
+}
+
+object *VECLIB_Len(object **args, const char **err) {
+	return OBJECT_NewInt(((arrayObject*)args[0]->value)->size);
+}
+
+object *VECLIB_Reserve(object **args, const char **err) {
+	arrayObject *a = (arrayObject*)args[0]->value;
+	OBJECT_VectorReserve(a, OBJECT_IntValue(args[1]));
+	return OBJECT_NewInt(a->cap);
+}
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
@@ -2,6 +2,7 @@
 #include "lexer.h" /* header file */
 #include "token.h" /* for the token */
 #include "memory.h" /* memory management */
+#include "arena.h" /* token storage */
 
 #include <stdio.h> /* for debugging and errors */
 #include <stdlib.h> /* precise control for memory management */
@@ -18,16 +19,17 @@ lexer *LEXER_NewLexer(const char *text) {
 	if (!l || l == NULL) /* failed allocation */
 		return NULL;
 
-	l->tokens = (token**)malloc(sizeof(token)*10);
+	l->tokens = (token**)malloc(sizeof(token*)*256);
 	l->index = -1;
 	l->lineno = 1;
 	l->colno = -1;
 	l->c_char = 0;
 	l->len_of_text = strlen(text);
 	l->text = text;
-	l->tokens_cap = 10;
+	l->tokens_cap = 256;
 	l->n_of_tokens = 0;
 	l->err = 0;
+	l->a = ARENA_NewArena(ARENA_BLOCK_SIZE);
 	LEXER_Advance(l);
 
 	return l;
@@ -54,19 +56,31 @@ void LEXER_Advance(lexer *l) {
 void LEXER_AddToken(lexer *l, token *t) {
 	/* resize the token list if necessary */
 	if (l->n_of_tokens >= l->tokens_cap) {
-		l->tokens = (token**)MEMORY_Realloc(l->tokens, sizeof(token) * l->tokens_cap * 2);
+		l->tokens = (token**)MEMORY_Realloc(l->tokens, sizeof(token*) * l->tokens_cap * 2);
 		l->tokens_cap *= 2;
 	}
 	/* add the token to the list */
 	l->tokens[l->n_of_tokens++] = t;
 }
 
-token *LEXER_MakeString(lexer *l) {
-	/* make a string token */
-	char *s = (char*)malloc(100); /* allocate a heap buffer */
-	if (!s || s == NULL) /* failed allocation */
+token *LEXER_NewToken(lexer *l, int type, const char *value, int lineno, int colno) {
+	/* allocate token in the arena */
+	token *t = (token*)ARENA_Alloc(l->a, sizeof(token));
+
+	if (t == NULL) /* allocation failed */
 		return NULL;
 
+	t->type = type; /* type of token */
+	t->id = TOKEN_ID_NONE; /* set by LEXER_MakeIdent for keywords */
+	t->value = value; /* value of token */
+	t->lineno = lineno; /* line of token */
+	t->colno = colno; /* column of token */
+
+	return t;
+}
+
+token *LEXER_MakeString(lexer *l) {
+	/* make a string token */
 	/* grab the line number and column number */
 	int lineno = l->lineno;
 	int colno = l->colno;
@@ -75,92 +89,124 @@ token *LEXER_MakeString(lexer *l) {
 
 	LEXER_Advance(l); /* advance */
 
-	int i = 0; /* index of chars */
+	int start = l->index; /* index of first char */
 
-	/* loop through while char is still not '"' or "'" and i is not greater than 100 */
-	while (l->c_char != quote && l->c_char != 0 && i < 100) {
-		s[i++] = l->c_char; /* store extra char */
+	/* loop through while char is still not '"' or "'" */
+	while (l->c_char != quote && l->c_char != 0)
 		LEXER_Advance(l);
-	}
 
-	if (i >= 100)
-		s[99] = '\0';
-	else
-		s[i] = '\0';
+	/* copy the chars into the arena */
+	char *s = ARENA_CopyString(l->a, l->text + start, l->index - start);
+	if (s == NULL) /* failed allocation */
+		return NULL;
 
 	/* broke out, so if char is not 0, advance */
 	if (l->c_char != 0)
 		LEXER_Advance(l);
 
 	/* return a new token */
-	return TOKEN_NewToken(TOKEN_STRING, s, lineno, colno);
+	return LEXER_NewToken(l, TOKEN_STRING, s, lineno, colno);
 }
 
 token *LEXER_MakeIdent(lexer *l) {
 	/* make an identifier token */
-	char *s = (char *)malloc(100); /* allocate a heap buffer */
-	if (!s || s == NULL) /* failed allocation */
-		return NULL;
-
 	/* grab line and column numbers */
 	int lineno = l->lineno;
 	int colno = l->colno;
 
-	int i = 0; /* counter to stop buffer overflow */
+	int start = l->index; /* index of first char */
 	/* loop through */
-	while ((is_ident(l->c_char) || is_int(l->c_char)) && l->c_char != 0 && i < 100) {
-		s[i++] = l->c_char;
+	while ((is_ident(l->c_char) || is_int(l->c_char)) && l->c_char != 0)
 		LEXER_Advance(l);
-	}
-	/* add null term char */
-	if (i >= 100) /* we've gotten to the end of the buffer limit */
-		s[99] = '\0';
-	else /* we haven't yet */
-		s[i] = '\0';
+
+	/* copy the chars into the arena */
+	char *s = ARENA_CopyString(l->a, l->text + start, l->index - start);
+	if (s == NULL) /* failed allocation */
+		return NULL;
 
 	/* default token type */
 	int tok_type = TOKEN_IDENT;
+	int id = LEXER_Keyword(s, l->index - start);
 
 	/* if keyword */
-	if (is_keyword(s))
+	if (id != TOKEN_ID_NONE && id < TOKEN_ID_INT)
 		tok_type = TOKEN_KWD;
 	/* variable declaration word */
-	else if (is_var_decl(s)) {
+	else if (id >= TOKEN_ID_INT)
 		tok_type = TOKEN_VAR_WORD;
-	}
 
 	/* return a new token */
-	return TOKEN_NewToken(tok_type, s, lineno, colno);
+	token *t = LEXER_NewToken(l, tok_type, s, lineno, colno);
+	if (t != NULL) t->id = id;
+	return t;
+}
+
+int LEXER_Keyword(const char *s, int len) {
+	/* pick the only word that could match by length and first char */
+	const char *w = NULL;
+	int id = TOKEN_ID_NONE;
+	switch (len) {
+		case 2:
+			if (s[0] == 'i') { w = "if"; id = TOKEN_ID_IF; }
+			else if (s[0] == 't') { w = "to"; id = TOKEN_ID_TO; }
+			else if (s[0] == 'f') { w = "fn"; id = TOKEN_ID_FN; }
+			break;
+		case 3:
+			if (s[0] == 'f') { w = "for"; id = TOKEN_ID_FOR; }
+			else if (s[0] == 'e') { w = "end"; id = TOKEN_ID_END; }
+			else if (s[0] == 'n') { w = "new"; id = TOKEN_ID_NEW; }
+			else if (s[0] == 'i') { w = "int"; id = TOKEN_ID_INT; }
+			else if (s[0] == 's') { w = "str"; id = TOKEN_ID_STR; }
+			else if (s[0] == 'v') { w = "vec"; id = TOKEN_ID_VEC; }
+			else if (s[0] == 'm') { w = "map"; id = TOKEN_ID_MAP; }
+			break;
+		case 4:
+			if (s[0] == 'p') { w = "puts"; id = TOKEN_ID_PUTS; }
+			else if (s[0] == 'c') { w = "char"; id = TOKEN_ID_CHAR; }
+			else if (s[0] == 'i') { w = "inst"; id = TOKEN_ID_INST; }
+			else if (s[0] == 's') { w = "step"; id = TOKEN_ID_STEP; }
+			break;
+		case 5:
+			if (s[0] == 'w') { w = "while"; id = TOKEN_ID_WHILE; }
+			else if (s[0] == 's') { w = "stdin"; id = TOKEN_ID_STDIN; }
+			else if (s[0] == 'f') { w = "float"; id = TOKEN_ID_FLOAT; }
+			break;
+		case 6:
+			if (s[0] == 'r') { w = "return"; id = TOKEN_ID_RETURN; }
+			else if (s[0] == 's' && s[1] == 'i') { w = "sizeof"; id = TOKEN_ID_SIZEOF; }
+			else if (s[0] == 's') { w = "struct"; id = TOKEN_ID_STRUCT; }
+			break;
+		case 7:
+			if (s[0] == 'i') { w = "include"; id = TOKEN_ID_INCLUDE; }
+			break;
+	}
+	/* compare the rest of the word */
+	if (w == NULL || memcmp(s + 1, w + 1, len - 1)) return TOKEN_ID_NONE;
+	return id;
 }
 
 token *LEXER_MakeInt(lexer *l) {
 	/* make an integer or float token */
-	char *s = (char *)malloc(100); /* allocate a heap buffer */
-	if (!s || s == NULL) /* failed allocation */
-		return NULL;
-
 	int dot_count = 0; /* number of dots */
 	/* grab line number and column number */
 	int lineno = l->lineno;
 	int colno = l->colno;
 
-	int i = 0; /* counter to stop buffer overflow */
+	int start = l->index; /* index of first char */
 
 	/* loop through */
-	while (dot_count < 2 && is_int_or_float(l->c_char) && l->c_char != 0 && i < 100) {
+	while (is_int_or_float(l->c_char) && l->c_char != 0) {
 		if (l->c_char == '.') /* check for '.' to create float */
 			dot_count++;
 		if (dot_count >= 2) /* we've reached a different token point */
-			continue; /* continue to let while loop finish */
-		s[i++] = l->c_char; /* add char and advance \/ */
+			break;
 		LEXER_Advance(l);
 	}
 
-	/* add null term char */
-	if (i >= 100)
-		s[99] = '\0';
-	else
-		s[i] = '\0';
+	/* copy the chars into the arena */
+	char *s = ARENA_CopyString(l->a, l->text + start, l->index - start);
+	if (s == NULL) /* failed allocation */
+		return NULL;
 
 	/* get the type of the token */
 	int tok_type = TOKEN_INT;
@@ -169,7 +215,7 @@ token *LEXER_MakeInt(lexer *l) {
 		tok_type = TOKEN_FLOAT;
 
 	/* return token */
-	return TOKEN_NewToken(tok_type, s, lineno, colno);
+	return LEXER_NewToken(l, tok_type, s, lineno, colno);
 }
 
 void LEXER_MakeTokens(lexer *l) {
@@ -183,7 +229,7 @@ void LEXER_MakeTokens(lexer *l) {
 		else if (is_int_or_float(l->c_char)) /* for ints and floats */
 			LEXER_AddToken(l, LEXER_MakeInt(l));
 		else if (l->c_char == '+') { /* '+' operator */ 
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_PLUS, "+", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_PLUS, "+", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == '-') { /* '-' operator */
@@ -195,19 +241,17 @@ void LEXER_MakeTokens(lexer *l) {
 				tok_type = TOKEN_ARROW;
 				LEXER_Advance(l);
 			}
-			char *s = (char*)malloc(3);
-			strcpy(s, "-");
-			if (tok_type == TOKEN_ARROW)
-				strcat(s, ">"); /* value of token for our sake of sanity */
+			/* value of token for our sake of sanity */
+			const char *s = tok_type == TOKEN_ARROW ? "->" : "-";
 			/* add the token */
-			LEXER_AddToken(l, TOKEN_NewToken(tok_type, s, lineno, colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, tok_type, s, lineno, colno));
 		}
 		else if (l->c_char == '*') { /* '*' operator */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_MUL, "*", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_MUL, "*", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == '/') { /* '/' operator or comment */
-			//LEXER_AddToken(l, TOKEN_NewToken(TOKEN_DIV, "/", l->lineno, l->colno));
+			//LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_DIV, "/", l->lineno, l->colno));
 			//LEXER_Advance(l);
 			LEXER_Advance(l);
 			/* check for comment */
@@ -239,14 +283,14 @@ void LEXER_MakeTokens(lexer *l) {
 					LEXER_Advance(l);
 			}
 			else /* '/' operator */
-				LEXER_AddToken(l, TOKEN_NewToken(TOKEN_DIV, "/", l->lineno, l->colno));
+				LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_DIV, "/", l->lineno, l->colno));
 		}
 		else if (l->c_char == '%') { /* '%' operator */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_MOD, "%", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_MOD, "%", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == '^') { /* '^' operator */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_POW, "^", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_POW, "^", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == '=') { /* '=', '==' operators */
@@ -258,57 +302,57 @@ void LEXER_MakeTokens(lexer *l) {
 				tok_type = TOKEN_EE;
 			}
 			if (tok_type == TOKEN_EQ) /* = */
-				LEXER_AddToken(l, TOKEN_NewToken(tok_type, "=", l->lineno, l->colno));
+				LEXER_AddToken(l, LEXER_NewToken(l, tok_type, "=", l->lineno, l->colno));
 			else /* == */
-				LEXER_AddToken(l, TOKEN_NewToken(tok_type, "==", l->lineno, l->colno));
+				LEXER_AddToken(l, LEXER_NewToken(l, tok_type, "==", l->lineno, l->colno));
 		}
 		else if (l->c_char == '(') { /* '(' */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_LPAREN, "(", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_LPAREN, "(", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == ')') { /* ')' */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_RPAREN, ")", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_RPAREN, ")", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == '{') { /* '{' */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_LSQUARE, "{", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_LSQUARE, "{", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == '}') { /* '}' */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_RSQUARE, "}", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_RSQUARE, "}", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == '[') { /* '[' */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_LBRACKET, "[", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_LBRACKET, "[", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == ']') { /* ']' */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_RBRACKET, "]", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_RBRACKET, "]", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == ':') { /* ':' */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_COLON, ":", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_COLON, ":", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == ',') { /* ',' */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_COMMA, ",", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_COMMA, ",", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == '$') { /* '$' */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_DOLLAR, "$", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_DOLLAR, "$", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == '<') { /* '<' */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_LT, "<", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_LT, "<", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == '>') { /* '>' */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_GT, ">", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_GT, ">", l->lineno, l->colno));
 			LEXER_Advance(l);
 		}
 		else if (l->c_char == ';') { /* end of line */
 			LEXER_Advance(l);
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_EOL, ";", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_EOL, ";", l->lineno, l->colno));
 		}
 		else if (l->c_char == '!') { /* '!=' */
 			LEXER_Advance(l);
@@ -321,7 +365,7 @@ void LEXER_MakeTokens(lexer *l) {
 			/* advance */
 			LEXER_Advance(l);
 			/* add token */
-			LEXER_AddToken(l, TOKEN_NewToken(TOKEN_NE, "!=", l->lineno, l->colno));
+			LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_NE, "!=", l->lineno, l->colno));
 		}
 		else if (is_whitespace(l->c_char)) /* whitespace found */
 			LEXER_Advance(l); /* advance */
@@ -333,15 +377,14 @@ void LEXER_MakeTokens(lexer *l) {
 		}
 	}
 	/* add eof (end of file) */
-	LEXER_AddToken(l, TOKEN_NewToken(TOKEN_EOF, "EOF", l->lineno, l->colno));
+	LEXER_AddToken(l, LEXER_NewToken(l, TOKEN_EOF, "EOF", l->lineno, l->colno));
 	/* finished */
 }
 
 void LEXER_FreeLexer(lexer *l) {
-	/* free lexer and tokens from memory */
-	for (int i = 0; i < l->n_of_tokens; i++) { /* loop through and free all tokens */
-		TOKEN_FreeToken(l->tokens[i]); /* free the token */
-	}
+	/* free lexer and tokens from memory; tokens and their values are all in the arena */
+	ARENA_FreeArena(l->a);
+	MEMORY_Free(l->tokens);
 	MEMORY_Free(l);
 }
 
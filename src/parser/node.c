@@ -2,78 +2,61 @@
 #include "node.h" /* our header */
 #include "token.h" /* tokens */
 #include "memory.h" /* memory management */
+#include "arena.h" /* node storage */
 
-#include <stdlib.h> /* realloc */
+#include <stdlib.h> /* NULL */
 #include <stdio.h> /* printf */
-#include <string.h> /* strlen, strcpy, ... */
+#include <string.h> /* strlen, memcpy */
 
 #ifdef __cplusplus /* c++ check */
 extern "C" {
 #endif
 
-node *NODE_NewNode(int type) {
+node *NODE_NewNode(arena *a, int type) {
 	/* allocate a new node */
-	node *n = MEMORY_Malloc(node);
+	node *n = (node*)ARENA_Alloc(a, sizeof(node));
 	/* failed allocation */
-	if (!n || n == NULL)
+	if (n == NULL)
 		return NULL;
 
 	/* assign values */
 	n->type = type; /* type of node */
-	n->tokens = (token**)malloc(sizeof(token*) * 8); /* tokens */
-	n->children = (node**)malloc(sizeof(node*) * 8); /* child nodes */
+	n->tokens = NULL; /* tokens */
+	n->children = NULL; /* child nodes */
 	n->n_of_children = 0; /* number of children */
 	n->n_of_toks = 0; /* number of tokens */
-	n->n_toks_cap = 8; /* capacity of token list */
-	n->n_children_cap = 8; /* capacity of children list */
+	n->lineno = 0; /* line number */
+	n->colno = 0; /* column number */
 	n->b = 0; /* boolean value for other things such as array declarations */
+	n->vtype = 255; /* no type name */
 	n->c = 0;
 	n->d = 0;
+	n->slot = 0;
 	return n; /* return new node */
 }
 
-void NODE_FreeNode(node *n) { /* deprecated, i recommended you use NODE_FreeChildren which automatically frees children as well */
-	/* free node */
-	MEMORY_Free(n);
+void **NODE_Grow(arena *a, void **list, unsigned int n) {
+	/* still room, since lists are full when their size is a power of two */
+	if (n != 0 && (n & (n - 1)) != 0)
+		return list;
+	/* move to a list twice the size; the old list stays in the arena */
+	void **new_list = (void**)ARENA_Alloc(a, sizeof(void*) * (n == 0 ? 1 : n * 2));
+	if (n > 0) memcpy(new_list, list, sizeof(void*) * n);
+	return new_list;
 }
 
-void NODE_FreeChildren(node *n) {
-	if (n->n_of_children > 0)
-		/* loop through children */
-		for (int i = 0; i < n->n_of_children; i++) {
-			/* free children and tokens */
-			NODE_FreeChildren(n->children[i]);
-		}
-	/* free token list */
-	MEMORY_Free(n->tokens);
-	/* free children list */
-	MEMORY_Free(n->children);
-	/* free the node */
-	MEMORY_Free(n);
-}
-
-node *NODE_AddChild(node *parent, node *child) {
+node *NODE_AddChild(arena *a, node *parent, node *child) {
 	/* check the capacity */
-	if (parent->n_of_children >= parent->n_children_cap) {
-		/* realloc list */
-		parent->children = (node**)realloc(parent->children, sizeof(node*) * parent->n_children_cap * 2);
-		/* update cap */
-		parent->n_children_cap *= 2;
-	}
+	parent->children = (node**)NODE_Grow(a, (void**)parent->children, parent->n_of_children);
 	/* add the token to next spot in list */
 	parent->children[parent->n_of_children++] = child;
 	/* return the parent node */
 	return parent;
 }
 
-node *NODE_AddToken(node *parent, token *t) {
+node *NODE_AddToken(arena *a, node *parent, token *t) {
 	/* check the capacity */
-	if (parent->n_of_toks >= parent->n_toks_cap) {
-		/* realloc list */
-		parent->tokens = (token**)realloc(parent->tokens, sizeof(token*) * parent->n_toks_cap * 2);
-		/* update cap */
-		parent->n_toks_cap *= 2;
-	}
+	parent->tokens = (token**)NODE_Grow(a, (void**)parent->tokens, parent->n_of_toks);
 	/* add the token to next spot in list */
 	parent->tokens[parent->n_of_toks++] = t;
 	/* return parent node */
@@ -84,44 +67,34 @@ node *NODE_AddToken(node *parent, token *t) {
 context: when calling functions from outside of the main file that the call is in, the body node of the
 function itself would have already been freed have we had not already copied the node and all it's contents.
 */
-node *NODE_CopyNode(node *n) {
+node *NODE_CopyNode(arena *a, node *n) {
 	/* allocate new node */
-	node *newNode = NODE_NewNode(n->type);
+	node *newNode = NODE_NewNode(a, n->type);
 	/* create copies of children */
 	for (int i = 0; i < n->n_of_children; i++) {
 		/* add child */
-		NODE_AddChild(newNode, NODE_CopyNode(n->children[i]));
+		NODE_AddChild(a, newNode, NODE_CopyNode(a, n->children[i]));
 	}
 	/* create copies of tokens */
 	for (int i = 0; i < n->n_of_toks; i++) {
-		/* create new value */
-		char *value = (char*)malloc(strlen(n->tokens[i]->value) + 2);
-		strcpy(value, n->tokens[i]->value);
-		/* create new token */
-		token *t = TOKEN_NewToken(n->tokens[i]->type, value, n->tokens[i]->lineno, n->tokens[i]->colno);
+		/* create new token with a copy of the value */
+		token *t = (token*)ARENA_Alloc(a, sizeof(token));
+		*t = *n->tokens[i];
+		if (t->value != NULL) t->value = ARENA_CopyString(a, t->value, strlen(t->value));
 		/* add token to node */
-		NODE_AddToken(newNode, t);
+		NODE_AddToken(a, newNode, t);
 	}
 	/* assign arbitrary values and line and column numbers */
 	newNode->lineno = n->lineno;
 	newNode->colno = n->colno;
 	newNode->b = n->b;
+	newNode->vtype = n->vtype;
 	newNode->c = n->c;
 	newNode->d = n->d;
 	/* return node */
 	return newNode;
 }
 
-void NODE_FreeCopyNode(node *n) {
-	/* free tokens */
-	for (int i = 0; i < n->n_of_toks; i++) {
-		/* free a token */
-		TOKEN_FreeToken(n->tokens[i]);
-	}
-	/* free node and it's children */
-	NODE_FreeChildren(n);
-}
-
 void NODE_PrintTree(node *n) {
 	/* check the type */
 	switch (n->type) {
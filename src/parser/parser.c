@@ -4,9 +4,11 @@
 #include "token.h" /* tokens */
 #include "memory.h" /* memory management */
 #include "error.h" /* errors */
+#include "arena.h" /* node storage */
+#include "object.h" /* resolving type names */
 
 #include <stdio.h> /* printf (for debugging) */
-#include <stdlib.h> /* atoi */
+#include <stdlib.h> /* atoi, atof */
 
 #ifdef __cplusplus /* c++ check */
 extern "C" {
@@ -25,6 +27,7 @@ parser *PARSER_NewParser(token **tokens, unsigned int n_of_toks) {
 	p->e = NULL;
 	p->pos = -1; /* position in token list */
 	p->n_of_toks = n_of_toks; /* number of tokens in list */
+	p->a = ARENA_NewArena(ARENA_BLOCK_SIZE); /* nodes */
 	/* advance to first token */
 	PARSER_Advance(p);
 	return p;
@@ -55,7 +58,7 @@ node *PARSER_CompExpr(parser *p) {
 
 node *PARSER_Statements(parser *p) {
 	/* allocate new node */
-	node *n = NODE_NewNode(NODE_STATEMENTS);
+	node *n = NODE_NewNode(p->a, NODE_STATEMENTS);
 
 	/* failed allocation */
 	if (!n || n == NULL)
@@ -70,24 +73,22 @@ node *PARSER_Statements(parser *p) {
 
 	/* failed to retrieve node or error */
 	if (p->e != NULL || next == NULL) {
-		/* free statement node */
-		if (next != NULL) NODE_FreeNode(next);
 		/* return */
 		return NULL;
 	}
 	/* add node as child */
-	NODE_AddChild(n, next);
+	NODE_AddChild(p->a, n, next);
 
 	/* set line and column numbers */
 	n->lineno = next->lineno;
 	n->colno = next->colno;
 
 	/* loop until token is not of type EOL */
-	while (p->current_token->type == TOKEN_EOL && !TOKEN_Matches(p->current_token, TOKEN_KWD, "end")) {
+	while (p->current_token->type == TOKEN_EOL && !TOKEN_Is(p->current_token, TOKEN_KWD, TOKEN_ID_END)) {
 		/* advance past ';' */
 		PARSER_Advance(p);
 		/* break at EOF */
-		if (p->current_token->type == TOKEN_EOF || TOKEN_Matches(p->current_token, TOKEN_KWD, "end"))
+		if (p->current_token->type == TOKEN_EOF || TOKEN_Is(p->current_token, TOKEN_KWD, TOKEN_ID_END))
 			break;
 		/* advance past more EOLs */
 		while (p->current_token->type == TOKEN_EOL)
@@ -97,14 +98,12 @@ node *PARSER_Statements(parser *p) {
 
 		/* error or memory failure */
 		if (p->e != NULL || next == NULL) {
-			/* free statement node */
-			NODE_FreeNode(next);
 			/* return */
 			return NULL;
 		}
 
 		/* add the next as child */
-		NODE_AddChild(n, next);
+		NODE_AddChild(p->a, n, next);
 	}
 
 	/* return node */
@@ -140,13 +139,13 @@ node *PARSER_Factor(parser *p) {
 			return NULL;
 
 		/* create new unop node */
-		node *n = NODE_NewNode(NODE_UNOP);
+		node *n = NODE_NewNode(p->a, NODE_UNOP);
 		/* failed allocation */
 		if (n == NULL)
 			return NULL;
 		/* add child and token */
-		NODE_AddChild(n, factor);
-		NODE_AddToken(n, tok);
+		NODE_AddChild(p->a, n, factor);
+		NODE_AddToken(p->a, n, tok);
 		/* assign line and column numbers */
 		n->lineno = tok->lineno;
 		n->colno = tok->colno;
@@ -162,12 +161,17 @@ node *PARSER_Factor(parser *p) {
 		if (tok->type == TOKEN_FLOAT)
 			node_type = NODE_FLOAT;
 		/* allocate new node */
-		node *n = NODE_NewNode(node_type);
+		node *n = NODE_NewNode(p->a, node_type);
 		/* failed allocation */
 		if (n == NULL)
 			return NULL;
 		/* add token */
-		NODE_AddToken(n, tok);
+		NODE_AddToken(p->a, n, tok);
+		/* decode the value once, so it isn't parsed again every time it is run */
+		if (node_type == NODE_FLOAT)
+			n->f = (float)atof(tok->value);
+		else
+			n->c = atoi(tok->value);
 		/* assign line and column numbers */
 		n->lineno = tok->lineno;
 		n->colno = tok->colno;
@@ -186,8 +190,6 @@ node *PARSER_Factor(parser *p) {
 		if (p->current_token->type != TOKEN_RPAREN) {
 			/* create error */
 			p->e = ERROR_InvalidSyntax("Expected ')'", p->current_token->lineno, p->current_token->colno);
-			/* free expression */
-			NODE_FreeChildren(expr);
 			return NULL; /* return */
 		}
 		/* advance */
@@ -199,19 +201,19 @@ node *PARSER_Factor(parser *p) {
 		/* advance */
 		PARSER_Advance(p);
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_STRING);
+		node *n = NODE_NewNode(p->a, NODE_STRING);
 		/* failed allocation */
 		if (n == NULL)
 			return NULL;
 		/* add token */
-		NODE_AddToken(n, tok);
+		NODE_AddToken(p->a, n, tok);
 		/* assign line and column numbers */
 		n->lineno = tok->lineno;
 		n->colno = tok->colno;
 		/* return node */
 		return n;
 	}
-	else if (TOKEN_Matches(tok, TOKEN_KWD, "while")) {
+	else if (TOKEN_Is(tok, TOKEN_KWD, TOKEN_ID_WHILE)) {
 		/* advance */
 		PARSER_Advance(p);
 		/* get expression */
@@ -223,40 +225,32 @@ node *PARSER_Factor(parser *p) {
 		node *statements = PARSER_Statements(p);
 		/* error or failed allocation */
 		if (statements == NULL || p->e != NULL) {
-			/* free stuff */
-			NODE_FreeChildren(comp_expr);
 			return NULL; /* exit */
 		}
 		/* expects 'end' */
-		if (!TOKEN_Matches(p->current_token, TOKEN_KWD, "end")) {
+		if (!TOKEN_Is(p->current_token, TOKEN_KWD, TOKEN_ID_END)) {
 			/* create error */
 			p->e = ERROR_InvalidSyntax("Expected 'end'", p->current_token->lineno, p->current_token->colno);
-			/* free stuff */
-			NODE_FreeChildren(comp_expr);
-			NODE_FreeChildren(statements);
 			return NULL; /* exit */
 		}
 		/* advance */
 		PARSER_Advance(p);
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_WHILE);
+		node *n = NODE_NewNode(p->a, NODE_WHILE);
 		/* failed allocation */
 		if (n == NULL) {
-			/* free stuff */
-			NODE_FreeChildren(comp_expr);
-			NODE_FreeChildren(statements);
 			return NULL; /* exit */
 		}
 		/* add children */
-		NODE_AddChild(n, comp_expr);
-		NODE_AddChild(n, statements);
+		NODE_AddChild(p->a, n, comp_expr);
+		NODE_AddChild(p->a, n, statements);
 		/* assign values */
 		n->lineno = tok->lineno;
 		n->colno = tok->colno;
 		/* return node */
 		return n;
 	}
-	else if (TOKEN_Matches(tok, TOKEN_KWD, "new")) {
+	else if (TOKEN_Is(tok, TOKEN_KWD, TOKEN_ID_NEW)) {
 		/* advanace */
 		PARSER_Advance(p);
 		/* expecting var word */
@@ -284,8 +278,6 @@ node *PARSER_Factor(parser *p) {
 			if (p->current_token->type != TOKEN_RBRACKET) {
 				/* create error */
 				p->e = ERROR_InvalidSyntax("Expected ']'", p->current_token->lineno, p->current_token->colno);
-				/* free node */
-				NODE_FreeChildren(expr);
 				return NULL; /* exit */
 			}
 			PARSER_Advance(p); /* advance */
@@ -293,28 +285,27 @@ node *PARSER_Factor(parser *p) {
 			is_array = 1;
 		}
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_NEW);
+		node *n = NODE_NewNode(p->a, NODE_NEW);
 		/* failed allocation */
 		if (n == NULL) {
-			/* free */
-			if (expr != NULL) NODE_FreeChildren(expr);
 			return NULL; /* exit */
 		}
 		/* add token and values */
-		NODE_AddToken(n, v_type);
-		if (expr != NULL) NODE_AddChild(n, expr);
+		NODE_AddToken(p->a, n, v_type);
+		if (expr != NULL) NODE_AddChild(p->a, n, expr);
 		n->b = is_array;
+		n->vtype = OBJECT_TypeOfName(v_type->id);
 		/* assign line and column numbers */
 		n->lineno = tok->lineno;
 		n->colno = tok->colno;
 		/* return node */
 		return n;
 	}
-	else if (TOKEN_Matches(tok, TOKEN_KWD, "stdin")) {
+	else if (TOKEN_Is(tok, TOKEN_KWD, TOKEN_ID_STDIN)) {
 		/* advance */
 		PARSER_Advance(p);
 		/* allocate node */
-		node *n = NODE_NewNode(NODE_STDIN);
+		node *n = NODE_NewNode(p->a, NODE_STDIN);
 		/* failed allocation */
 		if (n == NULL)
 			return NULL;
@@ -324,7 +315,7 @@ node *PARSER_Factor(parser *p) {
 		/* return node */
 		return n;
 	}
-	else if (TOKEN_Matches(tok, TOKEN_KWD, "fn")) {
+	else if (TOKEN_Is(tok, TOKEN_KWD, TOKEN_ID_FN)) {
 		/* advance */
 		PARSER_Advance(p);
 		/* expects identifier for name */
@@ -344,8 +335,8 @@ node *PARSER_Factor(parser *p) {
 		}
 		PARSER_Advance(p); /* advance */
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_FUNCDEF);
-		NODE_AddToken(n, func_name);
+		node *n = NODE_NewNode(p->a, NODE_FUNCDEF);
+		NODE_AddToken(p->a, n, func_name);
 		/* failed allocation */
 		if (n == NULL)
 			return NULL;
@@ -356,8 +347,6 @@ node *PARSER_Factor(parser *p) {
 			if (p->current_token->type != TOKEN_COLON) {
 				/* create error */
 				p->e = ERROR_InvalidSyntax("Expected ':'", p->current_token->lineno, p->current_token->colno);
-				/* free our node */
-				NODE_FreeChildren(n);
 				/* return */
 				return NULL;
 			}
@@ -367,8 +356,6 @@ node *PARSER_Factor(parser *p) {
 			if (p->current_token->type != TOKEN_VAR_WORD) {
 				/* create error */
 				p->e = ERROR_InvalidSyntax("Expected variable type", p->current_token->lineno, p->current_token->colno);
-				/* free our node */
-				NODE_FreeChildren(n);
 				/* return */
 				return NULL;
 			}
@@ -376,14 +363,12 @@ node *PARSER_Factor(parser *p) {
 			token *arg_type = p->current_token;
 			PARSER_Advance(p); /* advance */
 			/* add tokens to node */
-			NODE_AddToken(n, arg_name);
-			NODE_AddToken(n, arg_type);
+			NODE_AddToken(p->a, n, arg_name);
+			NODE_AddToken(p->a, n, arg_type);
 			/* expects ',' */
 			if (p->current_token->type != TOKEN_COMMA) {
 				/* create error */
 				p->e = ERROR_InvalidSyntax("Expected ','", p->current_token->lineno, p->current_token->colno);
-				/* free our children */
-				NODE_FreeChildren(n);
 				/* return */
 				return NULL;
 			}
@@ -394,8 +379,6 @@ node *PARSER_Factor(parser *p) {
 		if (p->current_token->type != TOKEN_RPAREN) {
 			/* create error */
 			p->e = ERROR_InvalidSyntax("Expected ')'", p->current_token->lineno, p->current_token->colno);
-			/* free our node */
-			NODE_FreeChildren(n);
 			/* return */
 			return NULL;
 		}
@@ -405,8 +388,6 @@ node *PARSER_Factor(parser *p) {
 		if (p->current_token->type != TOKEN_ARROW) {
 			/* create error */
 			p->e = ERROR_InvalidSyntax("Expected '->'", p->current_token->lineno, p->current_token->colno);
-			/* free our node */
-			NODE_FreeChildren(n);
 			/* return */
 			return NULL;
 		}
@@ -416,14 +397,13 @@ node *PARSER_Factor(parser *p) {
 		if (p->current_token->type != TOKEN_VAR_WORD) {
 			/* create error */
 			p->e = ERROR_InvalidSyntax("Expected variable type", p->current_token->lineno, p->current_token->colno);
-			/* free our node */
-			NODE_FreeChildren(n);
 			/* return */
 			return NULL;
 		}
 		/* pointer to return type token */
 		token *ret_type = p->current_token;
-		NODE_AddToken(n, ret_type); /* add token to list */
+		NODE_AddToken(p->a, n, ret_type); /* add token to list */
+		n->vtype = OBJECT_TypeOfName(ret_type->id); /* resolve return type */
 		/* advance */
 		PARSER_Advance(p);
 		/* ';' */
@@ -432,32 +412,27 @@ node *PARSER_Factor(parser *p) {
 		node *statements = PARSER_Statements(p);
 		/* error or failed allocation */
 		if (statements == NULL || p->e != NULL) {
-			/* free our node */
-			NODE_FreeChildren(n);
 			/* return */
 			return NULL;
 		}
 		/* expecting 'end' */
-		if (!TOKEN_Matches(p->current_token, TOKEN_KWD, "end")) {
+		if (!TOKEN_Is(p->current_token, TOKEN_KWD, TOKEN_ID_END)) {
 			/* create error */
 			p->e = ERROR_InvalidSyntax("Expected 'end'", p->current_token->lineno, p->current_token->colno);
-			/* free our node */
-			NODE_FreeChildren(n);
-			NODE_FreeChildren(statements);
 			/* return */
 			return NULL;
 		}
 		/* advance */
 		PARSER_Advance(p);
 		/* add the node */
-		NODE_AddChild(n, statements);
+		NODE_AddChild(p->a, n, statements);
 		/* assign line and column numbers */
 		n->lineno = tok->lineno;
 		n->colno = tok->colno;
 		/* return node */
 		return n;
 	}
-	else if (TOKEN_Matches(tok, TOKEN_KWD, "struct")) {
+	else if (TOKEN_Is(tok, TOKEN_KWD, TOKEN_ID_STRUCT)) {
 		/* advance */
 		PARSER_Advance(p);
 		/* expecting identifier */
@@ -476,18 +451,16 @@ node *PARSER_Factor(parser *p) {
 		/* integer for number of values */
 		int n_of_vals = 1;
 		/* allocate node */
-		node *n = NODE_NewNode(NODE_STRUCT);
+		node *n = NODE_NewNode(p->a, NODE_STRUCT);
 		/* bad allocation */
 		if (n == NULL || p->e != NULL)
 			return NULL;
 		/* add token */
-		NODE_AddToken(n, name);
+		NODE_AddToken(p->a, n, name);
 		/* expecting identifier */
 		if (p->current_token->type != TOKEN_IDENT) {
 			/* create error */
 			p->e = ERROR_InvalidSyntax("Expected identifier", p->current_token->lineno, p->current_token->colno);
-			/* free node */
-			NODE_FreeNode(n);
 			return NULL; /* exit */
 		}
 		/* name */
@@ -498,8 +471,6 @@ node *PARSER_Factor(parser *p) {
 		if (p->current_token->type != TOKEN_COLON) {
 			/* create error */
 			p->e = ERROR_InvalidSyntax("Expected ':'", p->current_token->lineno, p->current_token->colno);
-			/* free node */
-			NODE_FreeNode(n);
 			return NULL; /* exit */
 		}
 		/* advance */
@@ -508,8 +479,6 @@ node *PARSER_Factor(parser *p) {
 		if (p->current_token->type != TOKEN_VAR_WORD) {
 			/* create error */
 			p->e = ERROR_InvalidSyntax("Expected type name", p->current_token->lineno, p->current_token->colno);
-			/* free node */
-			NODE_FreeNode(n);
 			return NULL; /* exit */
 		}
 		/* type */
@@ -517,8 +486,8 @@ node *PARSER_Factor(parser *p) {
 		/* advance */
 		PARSER_Advance(p);
 		/* add tokens */
-		NODE_AddToken(n, val_name);
-		NODE_AddToken(n, val_type);
+		NODE_AddToken(p->a, n, val_name);
+		NODE_AddToken(p->a, n, val_type);
 		/* get other values */
 		while (p->current_token->type == TOKEN_COMMA) {
 			/* advance */
@@ -527,8 +496,6 @@ node *PARSER_Factor(parser *p) {
 			if (p->current_token->type != TOKEN_IDENT) {
 				/* create error */
 				p->e = ERROR_InvalidSyntax("Expected identifier", p->current_token->lineno, p->current_token->colno);
-				/* free node */
-				NODE_FreeNode(n);
 				return NULL; /* exit */
 			}
 			/* name */
@@ -539,8 +506,6 @@ node *PARSER_Factor(parser *p) {
 			if (p->current_token->type != TOKEN_COLON) {
 				/* create error */
 				p->e = ERROR_InvalidSyntax("Expected ':'", p->current_token->lineno, p->current_token->colno);
-				/* free node */
-				NODE_FreeNode(n);
 				return NULL; /* exit */
 			}
 			/* advance */
@@ -549,8 +514,6 @@ node *PARSER_Factor(parser *p) {
 			if (p->current_token->type != TOKEN_VAR_WORD) {
 				/* create error */
 				p->e = ERROR_InvalidSyntax("Expected type name", p->current_token->lineno, p->current_token->colno);
-				/* free node */
-				NODE_FreeNode(n);
 				return NULL; /* exit */
 			}
 			/* type */
@@ -558,19 +521,17 @@ node *PARSER_Factor(parser *p) {
 			/* advance */
 			PARSER_Advance(p);
 			/* add tokens */
-			NODE_AddToken(n, val_name);
-			NODE_AddToken(n, val_type);
+			NODE_AddToken(p->a, n, val_name);
+			NODE_AddToken(p->a, n, val_type);
 			n_of_vals++;
 		}
 		/* advance past newlines */
 		while (p->current_token->type == TOKEN_EOL)
 			PARSER_Advance(p); /* advance */
 		/* expects 'end' */
-		if (!TOKEN_Matches(p->current_token, TOKEN_KWD, "end")) {
+		if (!TOKEN_Is(p->current_token, TOKEN_KWD, TOKEN_ID_END)) {
 			/* create error */
 			p->e = ERROR_InvalidSyntax("Expected 'end'", p->current_token->lineno, p->current_token->colno);
-			/* free node */
-			NODE_FreeNode(n);
 			return NULL; /* exit */
 		}
 		PARSER_Advance(p); /* advance */
@@ -581,7 +542,7 @@ node *PARSER_Factor(parser *p) {
 		/* return node */
 		return n;
 	}
-	else if (TOKEN_Matches(tok, TOKEN_KWD, "include")) {
+	else if (TOKEN_Is(tok, TOKEN_KWD, TOKEN_ID_INCLUDE)) {
 		/* advance */
 		PARSER_Advance(p);
 		/* expects string as file name */
@@ -594,19 +555,19 @@ node *PARSER_Factor(parser *p) {
 		token *fname = p->current_token;
 		PARSER_Advance(p); /* advance */
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_INCLUDE);
+		node *n = NODE_NewNode(p->a, NODE_INCLUDE);
 		/* bad memory */
 		if (n == NULL)
 			return NULL;
 		/* add token */
-		NODE_AddToken(n, fname);
+		NODE_AddToken(p->a, n, fname);
 		/* assign line and column numbers */
 		n->lineno = tok->lineno;
 		n->colno = tok->colno;
 		/* return node */
 		return n;
 	}
-	else if (TOKEN_Matches(tok, TOKEN_KWD, "sizeof")) {
+	else if (TOKEN_Is(tok, TOKEN_KWD, TOKEN_ID_SIZEOF)) {
 		/* advance */
 		PARSER_Advance(p);
 		/* expects a type or an expression */
@@ -615,26 +576,25 @@ node *PARSER_Factor(parser *p) {
 		else a = 0;
 
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_SIZEOF);
+		node *n = NODE_NewNode(p->a, NODE_SIZEOF);
 		/* failed allocation */
 		if (n == NULL)
 			return NULL;
 		/* size of type */
 		if (a) {
 			/* add token */
-			NODE_AddToken(n, p->current_token);
+			NODE_AddToken(p->a, n, p->current_token);
+			n->vtype = OBJECT_TypeOfName(p->current_token->id);
 			PARSER_Advance(p); /* advance */
 		} else {
 			/* get the size of a value */
 			node *expr = PARSER_Expr(p); /* get an expression for value */
 			/* failed allocation or error */
 			if (p->e != NULL || expr == NULL) {
-				/* free original node */
-				NODE_FreeNode(n);
 				return NULL; /* exit */
 			}
 			/* add child node */
-			NODE_AddChild(n, expr);
+			NODE_AddChild(p->a, n, expr);
 		}
 		/* assign line and column numbers */
 		n->lineno = tok->lineno;
@@ -643,7 +603,7 @@ node *PARSER_Factor(parser *p) {
 		/* return node */
 		return n;
 	}
-	else if (TOKEN_Matches(tok, TOKEN_KWD, "for")) {
+	else if (TOKEN_Is(tok, TOKEN_KWD, TOKEN_ID_FOR)) {
 		/* advance */
 		PARSER_Advance(p);
 		/* expects var name */
@@ -668,7 +628,7 @@ node *PARSER_Factor(parser *p) {
 		if (start == NULL || p->e != NULL)
 			return NULL; /* exit */
 		/* expects 'to' */
-		if (!TOKEN_Matches(p->current_token, TOKEN_KWD, "to")) {
+		if (!TOKEN_Is(p->current_token, TOKEN_KWD, TOKEN_ID_TO)) {
 			/* create error */
 			p->e = ERROR_InvalidSyntax("Expected 'to'", p->current_token->lineno, p->current_token->colno);
 			return NULL; /* exit */
@@ -678,10 +638,18 @@ node *PARSER_Factor(parser *p) {
 		node *end = PARSER_Expr(p);
 		/* error or failed allocation */
 		if (end == NULL || p->e != NULL) {
-			/* free */
-			NODE_FreeChildren(start);
 			return NULL; /* exit */
 		}
+		/* 'step' */
+		node *step = NULL;
+		if (TOKEN_Is(p->current_token, TOKEN_KWD, TOKEN_ID_STEP)) {
+			PARSER_Advance(p); /* advance */
+			/* assign expr */
+			step = PARSER_Expr(p);
+			/* error or failed allocation */
+			if (step == NULL || p->e != NULL)
+				return NULL; /* exit */
+		}
 		/* loop past ';' */
 		while (p->current_token->type == TOKEN_EOL) PARSER_Advance(p);
 		/* get statements */
@@ -691,32 +659,29 @@ node *PARSER_Factor(parser *p) {
 			return NULL; /* exit */
 		}
 		/* expects 'end' */
-		if (!TOKEN_Matches(p->current_token, TOKEN_KWD, "end")) {
-			/* free statements */
-			NODE_FreeChildren(statements);
+		if (!TOKEN_Is(p->current_token, TOKEN_KWD, TOKEN_ID_END)) {
 			return NULL; /* exit */
 		}
 		PARSER_Advance(p); /* advance */
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_FORLOOP);
+		node *n = NODE_NewNode(p->a, NODE_FORLOOP);
 		/* failed allocation */
 		if (n == NULL) {
-			/* free statements */
-			NODE_FreeChildren(statements);
 			return NULL; /* exit */
 		}
 		/* add children and tokens */
-		NODE_AddChild(n, statements);
-		NODE_AddToken(n, var_name);
-		NODE_AddChild(n, start);
-		NODE_AddChild(n, end);
+		NODE_AddChild(p->a, n, statements);
+		NODE_AddToken(p->a, n, var_name);
+		NODE_AddChild(p->a, n, start);
+		NODE_AddChild(p->a, n, end);
+		if (step != NULL) NODE_AddChild(p->a, n, step);
 		/* assign line and column numbers */
 		n->lineno = tok->lineno;
 		n->colno = tok->colno;
 		/* return node */
 		return n;
 	}
-	else if (TOKEN_Matches(tok, TOKEN_KWD, "if")) {
+	else if (TOKEN_Is(tok, TOKEN_KWD, TOKEN_ID_IF)) {
 		/* advance */
 		PARSER_Advance(p);
 		/* get expression */
@@ -731,41 +696,32 @@ node *PARSER_Factor(parser *p) {
 		node *statements = PARSER_Statements(p);
 		/* error */
 		if (p->e != NULL || statements == NULL) {
-			/* free children nodes */
-			NODE_FreeChildren(comp_expr);
-			if (statements != NULL) NODE_FreeChildren(statements);
 			return NULL; /* exit */
 		}
 		/* expects 'end' */
-		if (!TOKEN_Matches(p->current_token, TOKEN_KWD, "end")) {
+		if (!TOKEN_Is(p->current_token, TOKEN_KWD, TOKEN_ID_END)) {
 			/* create error */
 			p->e = ERROR_InvalidSyntax("Expected 'end'", p->current_token->lineno, p->current_token->colno);
-			/* free stuff */
-			NODE_FreeChildren(comp_expr);
-			NODE_FreeChildren(statements);
 			return NULL; /* exit */
 		}
 		PARSER_Advance(p); /* advance */
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_IFNODE);
+		node *n = NODE_NewNode(p->a, NODE_IFNODE);
 		/* failed allocation */
 		if (n == NULL) {
-			/* free stuff */
-			NODE_FreeChildren(comp_expr);
-			NODE_FreeChildren(statements);
 			return NULL; /* exit */
 		}
 		/* add childs */
-		NODE_AddChild(n, comp_expr);
-		NODE_AddChild(n, statements);
+		NODE_AddChild(p->a, n, comp_expr);
+		NODE_AddChild(p->a, n, statements);
 		/* return node */
 		return n;
 	}
-	else if (TOKEN_Matches(tok, TOKEN_KWD, "puts")) {
+	else if (TOKEN_Is(tok, TOKEN_KWD, TOKEN_ID_PUTS)) {
 		/* advance */
 		PARSER_Advance(p);
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_PRINT);
+		node *n = NODE_NewNode(p->a, NODE_PRINT);
 		/* failed allocation */
 		if (n == NULL)
 			return NULL;
@@ -773,13 +729,11 @@ node *PARSER_Factor(parser *p) {
 		node *expr = PARSER_Expr(p);
 		/* failed allocation or error */
 		if (p->e != NULL || expr == NULL) {
-			/* free original node */
-			NODE_FreeNode(n);
 			/* return pointer to null */
 			return NULL;
 		}
 		/* add child node */
-		NODE_AddChild(n, expr);
+		NODE_AddChild(p->a, n, expr);
 		/* assign line and column numbers */
 		n->lineno = tok->lineno;
 		n->colno = tok->colno;
@@ -789,11 +743,61 @@ node *PARSER_Factor(parser *p) {
 	else if (tok->type == TOKEN_IDENT) {
 		/* advance */
 		PARSER_Advance(p);
+		/* '+=', '-=', '*=', '/=', '%=' */
+		int tps_3[5] = {TOKEN_PLUS,TOKEN_MINUS,TOKEN_MUL,TOKEN_DIV,TOKEN_MOD};
+		token *op_token = NULL;
+		if (is_int_in(p->current_token->type, tps_3, 5) && p->pos + 1 < p->n_of_toks && p->tokens[p->pos + 1]->type == TOKEN_EQ) {
+			op_token = p->current_token;
+			PARSER_Advance(p); /* advance to '=' */
+		}
+		/* '=' assign to a variable */
+		if (p->current_token->type == TOKEN_EQ) {
+			PARSER_Advance(p); /* advance */
+			node *value = PARSER_Expr(p); /* get our value */
+			/* failed allocation or error */
+			if (value == NULL || p->e != NULL) {
+				return NULL; /* exit */
+			}
+			/* 'x += y' is 'x = x + y' */
+			if (op_token != NULL) {
+				node *var = NODE_NewNode(p->a, NODE_VARAC);
+				node *binop = NODE_NewNode(p->a, NODE_BINOP);
+				/* failed allocation */
+				if (var == NULL || binop == NULL)
+					return NULL;
+				NODE_AddToken(p->a, var, tok);
+				NODE_AddChild(p->a, binop, var);
+				NODE_AddChild(p->a, binop, value);
+				NODE_AddToken(p->a, binop, op_token);
+				var->lineno = binop->lineno = tok->lineno;
+				var->colno = binop->colno = tok->colno;
+				/* a string is appended to in place, like 'str s = s + x;' */
+				if (op_token->type == TOKEN_PLUS) {
+					binop->b = 1;
+					var->b = 1;
+				}
+				value = binop;
+			}
+			/* allocate new node */
+			node *n = NODE_NewNode(p->a, NODE_ASSIGN);
+			/* failed allocation */
+			if (n == NULL) {
+				return NULL; /* exit */
+			}
+			/* add name and value */
+			NODE_AddToken(p->a, n, tok);
+			NODE_AddChild(p->a, n, value);
+			/* assign line and column numbers */
+			n->lineno = tok->lineno;
+			n->colno = tok->colno;
+			/* return node */
+			return n;
+		}
 		/* '(' function call */
 		if (p->current_token->type == TOKEN_LPAREN) {
 			PARSER_Advance(p); /* advance */
 			/* allocate new node */
-			node *n = NODE_NewNode(NODE_CALL);
+			node *n = NODE_NewNode(p->a, NODE_CALL);
 			/* failed allocation */
 			if (n == NULL)
 				return NULL;
@@ -803,12 +807,10 @@ node *PARSER_Factor(parser *p) {
 				node *expr = PARSER_Expr(p);
 				/* error or memory failure */
 				if (expr == NULL || p->e != NULL) {
-					/* free node */
-					NODE_FreeChildren(n);
 					return NULL; /* exit */
 				}
 				/* add as child node */
-				NODE_AddChild(n, expr);
+				NODE_AddChild(p->a, n, expr);
 			}
 			/* while ',' */
 			while (p->current_token->type == TOKEN_COMMA) {
@@ -818,24 +820,20 @@ node *PARSER_Factor(parser *p) {
 				node *expr = PARSER_Expr(p);
 				/* error or memory failure */
 				if (expr == NULL || p->e != NULL) {
-					/* free node */
-					NODE_FreeChildren(n);
 					return NULL; /* exit */
 				}
 				/* add as child node */
-				NODE_AddChild(n, expr);
+				NODE_AddChild(p->a, n, expr);
 			}
 			/* expects ')' */
 			if (p->current_token->type != TOKEN_RPAREN) {
 				/* create runtime error */
 				p->e = ERROR_InvalidSyntax("Expected ')'", p->current_token->lineno, p->current_token->colno);
-				/* free node */
-				NODE_FreeChildren(n);
 				return NULL; /* exit */
 			}
 			PARSER_Advance(p); /* advance */
 			/* add name */
-			NODE_AddToken(n, tok);
+			NODE_AddToken(p->a, n, tok);
 			/* assign line and column numbers */
 			n->lineno = tok->lineno;
 			n->colno = tok->colno;
@@ -854,8 +852,6 @@ node *PARSER_Factor(parser *p) {
 			if (p->current_token->type != TOKEN_RBRACKET) {
 				/* create error */
 				p->e = ERROR_InvalidSyntax("Expected ']'", p->current_token->lineno, p->current_token->colno);
-				/* free expr */
-				NODE_FreeChildren(expr);
 				return NULL; /* exit */
 			}
 			/* advance */
@@ -866,23 +862,19 @@ node *PARSER_Factor(parser *p) {
 				node *value = PARSER_Expr(p); /* get our value */
 				/* failed allocation or error */
 				if (value == NULL || p->e != NULL) {
-					/* free expr */
-					NODE_FreeChildren(expr);
 					return NULL; /* exit */
 				}
 				/* allocate new node */
-				node *n = NODE_NewNode(NODE_SETITEM);
+				node *n = NODE_NewNode(p->a, NODE_SETITEM);
 				/* failed allocation */
 				if (n == NULL) {
-					NODE_FreeChildren(expr);
-					NODE_FreeChildren(value);
 					return NULL; /* exit */
 				}
 				/* add childs */
-				NODE_AddChild(n, expr);
-				NODE_AddToken(n, tok);
+				NODE_AddChild(p->a, n, expr);
+				NODE_AddToken(p->a, n, tok);
 				/* add more childs */
-				NODE_AddChild(n, value);
+				NODE_AddChild(p->a, n, value);
 				/* assign line and column numbers */
 				n->lineno = tok->lineno;
 				n->colno = tok->colno;
@@ -890,15 +882,14 @@ node *PARSER_Factor(parser *p) {
 				return n;
 			}
 			/* allocate new node */
-			node *n = NODE_NewNode(NODE_GETITEM);
+			node *n = NODE_NewNode(p->a, NODE_GETITEM);
 			/* failed allocation */
 			if (n == NULL) {
-				NODE_FreeChildren(expr); /* free expr */
 				return NULL; /* exit */
 			}
 			/* add child */
-			NODE_AddChild(n, expr);
-			NODE_AddToken(n, tok);
+			NODE_AddChild(p->a, n, expr);
+			NODE_AddToken(p->a, n, tok);
 			/* assign line and column numbers */
 			n->lineno = tok->lineno;
 			n->colno = tok->colno;
@@ -906,12 +897,12 @@ node *PARSER_Factor(parser *p) {
 			return n;
 		}
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_VARAC);
+		node *n = NODE_NewNode(p->a, NODE_VARAC);
 		/* failed allocation */
 		if (n == NULL)
 			return NULL;
 		/* add name */
-		NODE_AddToken(n, tok);
+		NODE_AddToken(p->a, n, tok);
 		/* assign line and column numbers */
 		n->lineno = tok->lineno;
 		n->colno = tok->colno;
@@ -922,7 +913,7 @@ node *PARSER_Factor(parser *p) {
 		/* advance */
 		PARSER_Advance(p);
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_VALUE);
+		node *n = NODE_NewNode(p->a, NODE_VALUE);
 		/* failed allocation */
 		if (n == NULL)
 			return NULL;
@@ -930,13 +921,10 @@ node *PARSER_Factor(parser *p) {
 		node *expr = PARSER_Expr(p);
 		/* error or memory failure */
 		if (p->e != NULL || expr == NULL) {
-			/* free */
-			NODE_FreeChildren(expr);
-			NODE_FreeNode(n);
 			return NULL; /* exit */
 		}
 		/* add node */
-		NODE_AddChild(n, expr);
+		NODE_AddChild(p->a, n, expr);
 		/* return node */
 		return n;
 	}
@@ -944,7 +932,7 @@ node *PARSER_Factor(parser *p) {
 		/* advance */
 		PARSER_Advance(p);
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_ADDRESS);
+		node *n = NODE_NewNode(p->a, NODE_ADDRESS);
 		/* failed allocation */
 		if (n == NULL)
 			return NULL;
@@ -952,13 +940,10 @@ node *PARSER_Factor(parser *p) {
 		node *expr = PARSER_Expr(p);
 		/* error or memory failure */
 		if (p->e != NULL || expr == NULL) {
-			/* free expr */
-			if (expr != NULL) NODE_FreeChildren(expr);
-			NODE_FreeNode(n);
 			return NULL; /* exit */
 		}
 		/* add child node */
-		NODE_AddChild(n, expr);
+		NODE_AddChild(p->a, n, expr);
 		/* return node */
 		return n;
 	}
@@ -1001,13 +986,15 @@ node *PARSER_Factor(parser *p) {
 		/* advance */
 		PARSER_Advance(p);
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_ARRAY);
+		node *n = NODE_NewNode(p->a, NODE_ARRAY);
 		/* failed allocation */
 		if (n == NULL)
 			return NULL;
 		/* add tokens */
-		NODE_AddToken(n, var_type);
-		NODE_AddToken(n, array_size);
+		NODE_AddToken(p->a, n, var_type);
+		NODE_AddToken(p->a, n, array_size);
+		n->vtype = OBJECT_TypeOfName(var_type->id);
+		n->c = atoi(array_size->value);
 		/* assign line and column numbers */
 		n->lineno = tok->lineno;
 		n->colno = tok->colno;
@@ -1067,27 +1054,31 @@ node *PARSER_Factor(parser *p) {
 		var_value = PARSER_Expr(p);
 		/* failed allocation or error */
 		if (var_value == NULL || p->e != NULL) {
-			/* free value */
-			NODE_FreeNode(var_value);
 			/* return */
 			return NULL;
 		}
 		/* allocate new node */
-		node *n = NODE_NewNode(NODE_VARDEC);
+		node *n = NODE_NewNode(p->a, NODE_VARDEC);
 		/* failed allocation */
 		if (n == NULL) {
-			NODE_FreeChildren(var_value); /* free value */
 			return NULL; /* exit */
 		}
 		/* add tokens and nodes */
-		NODE_AddToken(n, var_name);
-		NODE_AddToken(n, var_type);
-		NODE_AddChild(n, var_value);
+		NODE_AddToken(p->a, n, var_name);
+		NODE_AddToken(p->a, n, var_type);
+		NODE_AddChild(p->a, n, var_value);
 		/* assign line and column numbers as well as array stuff */
 		n->lineno = var_type->lineno;
 		n->colno = var_type->colno;
 		n->b = is_array;
 		n->c = array_size;
+		n->vtype = OBJECT_TypeOfName(var_type->id);
+		/* mark 'str s = s + x;', so that the string can be appended to in place */
+		if (!is_array && n->vtype == OBJECT_STRING && var_value->type == NODE_BINOP && var_value->tokens[0]->type == TOKEN_PLUS
+			&& var_value->children[0]->type == NODE_VARAC && !strcmp(var_value->children[0]->tokens[0]->value, var_name->value)) {
+			var_value->b = 1;
+			var_value->children[0]->b = 1;
+		}
 		/* return node */
 		return n;
 	}
@@ -1123,12 +1114,12 @@ node *PARSER_BinOp(parser *p, node* (*func)(parser*), int types[], int n_of_type
 		right = func(p);
 
 		/* allocate new */
-		n = NODE_NewNode(NODE_BINOP);
+		n = NODE_NewNode(p->a, NODE_BINOP);
 		/* add children */
-		NODE_AddChild(n, left); /* left node */
-		NODE_AddChild(n, right); /* right node */
+		NODE_AddChild(p->a, n, left); /* left node */
+		NODE_AddChild(p->a, n, right); /* right node */
 		/* add token */
-		NODE_AddToken(n, op_token);
+		NODE_AddToken(p->a, n, op_token);
 		/* assign line and column numbers */
 		n->lineno = left->lineno;
 		n->colno = left->colno;
@@ -1140,10 +1131,8 @@ node *PARSER_BinOp(parser *p, node* (*func)(parser*), int types[], int n_of_type
 }
 
 void PARSER_FreeParser(parser *p) {
-	/* free the node if it exists */
-	if (p->newNode != NULL) {
-		NODE_FreeChildren(p->newNode); /* automatically free node and children */
-	}
+	/* free the nodes, which are all in the arena */
+	ARENA_FreeArena(p->a);
 	/* free error */
 	if (p->e != NULL) ERROR_FreeError(p->e);
 	/* free the parser */
@@ -15,6 +15,7 @@ token *TOKEN_NewToken(int type, const char *value, int lineno, int colno) {
 		return NULL;
 
 	t->type = type; /* type of token */
+	t->id = TOKEN_ID_NONE; /* not a keyword */
 	t->value = value; /* value of token */
 	t->lineno = lineno; /* line of token */
 	t->colno = colno; /* column of token */
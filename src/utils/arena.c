@@ -0,0 +1,125 @@
+/* see arena.h for documentation */
+#include "arena.h" /* our header */
+#include "memory.h" /* memory management */
+
+#include <stdlib.h> /* malloc/free */
+#include <string.h> /* memcpy */
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+arena *ARENA_NewArena(int block_sz) {
+	/* allocate new arena */
+	arena *a = MEMORY_Malloc(arena);
+	/* failed allocation */
+	if (a == NULL)
+		return NULL;
+	/* blocks are made when they are needed */
+	a->head = NULL;
+	a->spare = NULL;
+	a->block_sz = block_sz;
+	return a;
+}
+
+void ARENA_FreeArena(arena *a) {
+	/* free every block */
+	arenaBlock *b = a->head;
+	while (b != NULL) {
+		arenaBlock *next = b->next;
+		free(b);
+		b = next;
+	}
+	free(a->spare);
+	/* free arena */
+	MEMORY_Free(a);
+}
+
+void *ARENA_Alloc(arena *a, int sz) {
+	/* round up so the next allocation is aligned */
+	sz = (sz + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+	/* large allocations get a block of their own, kept behind the current block */
+	if (sz > a->block_sz && a->head != NULL) {
+		arenaBlock *b = (arenaBlock*)malloc(sizeof(arenaBlock) + sz);
+		/* failed allocation */
+		if (b == NULL)
+			return NULL;
+		b->next = a->head->next;
+		b->used = sz;
+		b->cap = sz;
+		a->head->next = b;
+		return (void*)(b + 1);
+	}
+	/* not enough room in the current block */
+	if (a->head == NULL || a->head->used + sz > a->head->cap) {
+		int cap = sz > a->block_sz ? sz : a->block_sz;
+		arenaBlock *b;
+		/* use the released block if there is one */
+		if (cap == a->block_sz && a->spare != NULL) {
+			b = a->spare;
+			a->spare = NULL;
+		}
+		else {
+			b = (arenaBlock*)malloc(sizeof(arenaBlock) + cap);
+			/* failed allocation */
+			if (b == NULL)
+				return NULL;
+		}
+		b->next = a->head;
+		b->used = 0;
+		b->cap = cap;
+		a->head = b;
+	}
+	/* hand out the next bytes */
+	void *p = (char*)(a->head + 1) + a->head->used;
+	a->head->used += sz;
+	return p;
+}
+
+char *ARENA_CopyString(arena *a, const char *s, int len) {
+	/* copy the chars and add a null term */
+	char *c = (char*)ARENA_Alloc(a, len + 1);
+	if (c == NULL)
+		return NULL;
+	memcpy(c, s, len);
+	c[len] = '\0';
+	return c;
+}
+
+arenaMark ARENA_Mark(arena *a) {
+	arenaMark m;
+	/* where the next allocation would go */
+	m.block = a->head;
+	m.next = a->head != NULL ? a->head->next : NULL;
+	m.used = a->head != NULL ? a->head->used : 0;
+	return m;
+}
+
+void ARENA_Release(arena *a, arenaMark m) {
+	/* free the blocks made since the mark, keeping one for later */
+	arenaBlock *b = a->head;
+	while (b != m.block) {
+		arenaBlock *next = b->next;
+		if (a->spare == NULL && b->cap == a->block_sz) a->spare = b;
+		else free(b);
+		b = next;
+	}
+	a->head = m.block;
+	/* nothing was handed out before the mark */
+	if (m.block == NULL)
+		return;
+	/* free the large blocks put behind the marked block since the mark */
+	b = m.block->next;
+	while (b != m.next) {
+		arenaBlock *next = b->next;
+		free(b);
+		b = next;
+	}
+	m.block->next = m.next;
+	/* hand out the same bytes again */
+	m.block->used = m.used;
+}
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
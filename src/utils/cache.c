@@ -0,0 +1,246 @@
+/* see cache.h for documentation */
+#include "cache.h" /* our header */
+#include "node.h" /* nodes */
+#include "token.h" /* tokens */
+#include "names.h" /* fnv-1a hash */
+#include "arena.h" /* nodes and tokens of loaded trees */
+#include "os.h" /* WINDOWS */
+
+#include <stdlib.h> /* malloc/realloc/free */
+#include <string.h> /* memcpy, strlen */
+#include <stdio.h> /* FILE, rename */
+#ifdef WINDOWS
+#include <process.h> /* _getpid */
+#else
+#include <unistd.h> /* getpid */
+#endif
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+int CACHE_Enabled; /* 0 if trees are never read from or written to the disk */
+#endif
+
+/* id of this process, so runs writing the same cache use different temporary files */
+#ifdef WINDOWS
+#define CACHE_Pid() _getpid()
+#else
+#define CACHE_Pid() getpid()
+#endif
+
+char *CACHE_Path(const char *path) {
+	/* same name with a 'c' on the end */
+	char *cpath = (char*)malloc(strlen(path) + 2);
+	strcpy(cpath, path);
+	strcat(cpath, "c");
+	return cpath;
+}
+
+void CACHE_WriteBytes(cacheBuffer *c, const char *s, int len) {
+	/* check the capacity */
+	while (c->sz + len > c->cap) {
+		/* realloc buffer */
+		c->buf = (char*)realloc(c->buf, c->cap * 2);
+		/* update cap */
+		c->cap *= 2;
+	}
+	/* add the bytes */
+	memcpy(c->buf + c->sz, s, len);
+	c->sz += len;
+}
+
+void CACHE_WriteInt(cacheBuffer *c, int x) {
+	/* move the sign to the lowest bit so small negative numbers are small too */
+	unsigned int u = ((unsigned int)x << 1) ^ (unsigned int)(x >> 31);
+	char bytes[5];
+	int len = 0;
+	/* 7 bits at a time, lowest first */
+	while (u >= 0x80) {
+		bytes[len++] = (char)((u & 0x7f) | 0x80);
+		u >>= 7;
+	}
+	bytes[len++] = (char)u;
+	CACHE_WriteBytes(c, bytes, len);
+}
+
+void CACHE_WriteNode(cacheBuffer *c, node *n) {
+	/* node */
+	CACHE_WriteInt(c, n->type);
+	CACHE_WriteInt(c, n->lineno);
+	CACHE_WriteInt(c, n->colno);
+	CACHE_WriteInt(c, n->b);
+	CACHE_WriteInt(c, n->vtype);
+	CACHE_WriteInt(c, n->c);
+	CACHE_WriteInt(c, n->d);
+	CACHE_WriteInt(c, n->n_of_toks);
+	CACHE_WriteInt(c, n->n_of_children);
+	/* tokens */
+	for (int k = 0; k < n->n_of_toks; k++) {
+		token *t = n->tokens[k];
+		CACHE_WriteInt(c, t->type);
+		CACHE_WriteInt(c, t->id);
+		CACHE_WriteInt(c, t->lineno);
+		CACHE_WriteInt(c, t->colno);
+		/* value with its null term */
+		if (t->value == NULL)
+			CACHE_WriteInt(c, -1);
+		else {
+			int len = strlen(t->value);
+			CACHE_WriteInt(c, len);
+			CACHE_WriteBytes(c, t->value, len + 1);
+		}
+	}
+	/* children */
+	for (int k = 0; k < n->n_of_children; k++)
+		CACHE_WriteNode(c, n->children[k]);
+}
+
+int CACHE_ReadInt(cacheBuffer *c) {
+	unsigned int u = 0;
+	/* 7 bits at a time, lowest first */
+	for (int shift = 0; shift < 35; shift += 7) {
+		/* past the end */
+		if (c->pos >= c->sz) {
+			c->err = 1;
+			return 0;
+		}
+		unsigned char b = (unsigned char)c->buf[c->pos++];
+		u |= (unsigned int)(b & 0x7f) << shift;
+		/* last byte; move the sign back */
+		if (!(b & 0x80)) return (int)(u >> 1) ^ -(int)(u & 1);
+	}
+	/* too many bytes */
+	c->err = 1;
+	return 0;
+}
+
+node *CACHE_ReadNode(arena *a, cacheBuffer *c) {
+	/* node */
+	node *n = NODE_NewNode(a, CACHE_ReadInt(c));
+	n->lineno = CACHE_ReadInt(c);
+	n->colno = CACHE_ReadInt(c);
+	n->b = CACHE_ReadInt(c);
+	n->vtype = CACHE_ReadInt(c);
+	n->c = CACHE_ReadInt(c);
+	n->d = CACHE_ReadInt(c);
+	int n_of_toks = CACHE_ReadInt(c);
+	int n_of_children = CACHE_ReadInt(c);
+	/* tokens */
+	for (int k = 0; k < n_of_toks && !c->err; k++) {
+		int type = CACHE_ReadInt(c);
+		int id = CACHE_ReadInt(c);
+		int lineno = CACHE_ReadInt(c);
+		int colno = CACHE_ReadInt(c);
+		int len = CACHE_ReadInt(c);
+		/* value stays in the buffer */
+		const char *value = NULL;
+		if (len >= 0) {
+			/* past the end or not terminated */
+			if (len >= c->sz - c->pos || c->buf[c->pos + len] != '\0') {
+				c->err = 1;
+				break;
+			}
+			value = c->buf + c->pos;
+			c->pos += len + 1;
+		}
+		token *t = (token*)ARENA_Alloc(a, sizeof(token));
+		t->type = type;
+		t->id = id;
+		t->value = value;
+		t->lineno = lineno;
+		t->colno = colno;
+		NODE_AddToken(a, n, t);
+	}
+	/* children */
+	for (int k = 0; k < n_of_children && !c->err; k++)
+		NODE_AddChild(a, n, CACHE_ReadNode(a, c));
+	return n;
+}
+
+node *CACHE_Load(const char *path, const char *text, char **buf, arena **a) {
+	/* open the cache */
+	char *cpath = CACHE_Path(path);
+	FILE *fp = fopen(cpath, "rb");
+	free(cpath);
+	if (fp == NULL) return NULL;
+	/* read it all at once */
+	cacheBuffer c;
+	fseek(fp, 0, SEEK_END);
+	c.sz = (int)ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	if (c.sz < 0) c.sz = 0;
+	c.buf = (char*)malloc(c.sz + 1);
+	c.sz = (int)fread(c.buf, 1, c.sz, fp);
+	c.pos = 0;
+	c.cap = c.sz;
+	c.err = 0;
+	fclose(fp);
+
+	/* check the header */
+	int text_len = strlen(text);
+	if (c.sz < 4 || memcmp(c.buf, "ADMC", 4)) {
+		free(c.buf);
+		return NULL;
+	}
+	c.pos = 4;
+	if (CACHE_ReadInt(&c) != CACHE_VERSION || (unsigned int)CACHE_ReadInt(&c) != NAMES_Hash(text)
+		|| CACHE_ReadInt(&c) != text_len || c.err) {
+		/* made from different text or by a different version */
+		free(c.buf);
+		return NULL;
+	}
+	/* read the tree */
+	arena *na = ARENA_NewArena(ARENA_BLOCK_SIZE);
+	node *tree = CACHE_ReadNode(na, &c);
+	/* damaged */
+	if (c.err || c.pos != c.sz) {
+		ARENA_FreeArena(na);
+		free(c.buf);
+		return NULL;
+	}
+	/* buffer holds the values of tokens, arena holds the rest */
+	*buf = c.buf;
+	*a = na;
+	return tree;
+}
+
+void CACHE_Save(const char *path, const char *text, node *tree) {
+	/* build the cache in memory */
+	cacheBuffer c;
+	c.buf = (char*)malloc(4096);
+	c.pos = 0;
+	c.sz = 0;
+	c.cap = 4096;
+	c.err = 0;
+	CACHE_WriteBytes(&c, "ADMC", 4);
+	CACHE_WriteInt(&c, CACHE_VERSION);
+	CACHE_WriteInt(&c, (int)NAMES_Hash(text));
+	CACHE_WriteInt(&c, strlen(text));
+	CACHE_WriteNode(&c, tree);
+	/* write it to a temporary file next to the cache, if the directory can be written to, and
+	move it into place once it is complete; another run never reads or writes a partial cache */
+	char *cpath = CACHE_Path(path);
+	char *tpath = (char*)malloc(strlen(cpath) + 32);
+	sprintf(tpath, "%s.%d.tmp", cpath, (int)CACHE_Pid());
+	FILE *fp = fopen(tpath, "wb");
+	if (fp != NULL) {
+		int ok = fwrite(c.buf, 1, c.sz, fp) == (size_t)c.sz;
+		ok = fclose(fp) == 0 && ok;
+#ifdef WINDOWS
+		/* rename doesn't replace an existing file on windows */
+		if (ok) remove(cpath);
+#endif
+		/* don't leave a partial cache behind */
+		if (!ok || rename(tpath, cpath) != 0) remove(tpath);
+	}
+	/* free stuff */
+	free(tpath);
+	free(cpath);
+	free(c.buf);
+}
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
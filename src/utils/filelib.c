@@ -89,35 +89,21 @@ int readline(file *f, char *buf, int buf_sz) {
 }
 
 char *read(file *f) {
-	/* create a buffer */
-	char *buf = (char *)malloc(100);
-	char c; /* character to append to buffer */
+	/* find the size of the file */
+	fseek(f->fp, 0, SEEK_END);
+	long size = ftell(f->fp);
+	fseek(f->fp, 0, SEEK_SET);
+	if (size < 0) size = 0;
 
-	int buf_sz = 100; /* buffer size */
-	int buf_pos = 0; /* buffer position */
+	/* create a buffer big enough for the file and null term */
+	char *buf = (char *)malloc(size + 1);
 
 	/* failed allocation */
 	if (!buf || buf == NULL)
 		return NULL;
 
-	c = fgetc(f->fp); /* get the first char */
-
-	while (c != EOF) {
-		if (buf_pos >= buf_sz) { /* make buffer bigger */
-			buf = (char*)realloc(buf, buf_sz*2);
-			buf_sz *= 2;
-		}
-		buf[buf_pos++] = c; /* add char */
-
-		/* get next char */
-		c = getc(f->fp);
-	}
-
-	/* realloc if not big enough for null term */
-	if (buf_pos >= buf_sz) {
-		buf = (char*)realloc(buf, buf_sz*2);
-		buf_sz *= 2;
-	}
+	/* read the whole file at once; text mode may read fewer chars than the size */
+	size_t buf_pos = fread(buf, 1, size, f->fp);
 	buf[buf_pos] = '\0'; /* add null term char */
 
 	/* return the text */
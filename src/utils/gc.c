@@ -0,0 +1,233 @@
+/* see gc.h for documentation */
+#include "gc.h" /* our header */
+#include "object.h" /* objects */
+#include "storage.h" /* registered objects */
+#include "names.h" /* variables */
+#include "interpreter.h" /* interpreter stacks */
+
+#include <stdlib.h> /* malloc/realloc/free */
+#include <stdio.h> /* printf */
+#include <time.h> /* clock */
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+int GC_Enabled; /* 0 if objects are kept until the end of the program */
+int GC_Threshold; /* collect when this many objects are registered */
+object **GC_Roots; /* temporary roots */
+int GC_RootsSz; /* number of temporary roots */
+int GC_RootsCap; /* capacity of temporary roots */
+interpreter **GC_Interpreters; /* running interpreters */
+int GC_InterpretersSz; /* number of running interpreters */
+int GC_InterpretersCap; /* capacity of running interpreters */
+int GC_Collections; /* number of collections */
+int GC_Freed; /* number of objects freed by the collector */
+int GC_PeakHeap; /* most objects registered at once */
+double GC_TotalPause; /* time spent collecting, in seconds */
+double GC_MaxPause; /* longest collection, in seconds */
+#endif
+
+void GC_Init() {
+	/* enabled unless turned off */
+	GC_Enabled = 1;
+	GC_Threshold = GC_MIN_THRESHOLD;
+	/* create the lists */
+	GC_Roots = (object**)malloc(sizeof(object*) * 64);
+	GC_RootsSz = 0;
+	GC_RootsCap = 64;
+	GC_Interpreters = (interpreter**)malloc(sizeof(interpreter*) * 8);
+	GC_InterpretersSz = 0;
+	GC_InterpretersCap = 8;
+	/* statistics */
+	GC_Collections = 0;
+	GC_Freed = 0;
+	GC_PeakHeap = 0;
+	GC_TotalPause = 0;
+	GC_MaxPause = 0;
+}
+
+void GC_FreeAll() {
+	/* free the lists */
+	free(GC_Roots);
+	free(GC_Interpreters);
+}
+
+void GC_PushRoot(object *o) {
+	/* check the capacity */
+	if (GC_RootsSz >= GC_RootsCap) {
+		/* realloc list */
+		GC_Roots = (object**)realloc(GC_Roots, sizeof(object*) * GC_RootsCap * 2);
+		/* update cap */
+		GC_RootsCap *= 2;
+	}
+	/* add the root */
+	GC_Roots[GC_RootsSz++] = o;
+}
+
+void GC_PopRoots(int sz) {
+	/* forget roots above sz */
+	GC_RootsSz = sz;
+}
+
+void GC_AddInterpreter(interpreter *i) {
+	/* check the capacity */
+	if (GC_InterpretersSz >= GC_InterpretersCap) {
+		/* realloc list */
+		GC_Interpreters = (interpreter**)realloc(GC_Interpreters, sizeof(interpreter*) * GC_InterpretersCap * 2);
+		/* update cap */
+		GC_InterpretersCap *= 2;
+	}
+	/* add the interpreter */
+	GC_Interpreters[GC_InterpretersSz++] = i;
+}
+
+void GC_RemoveInterpreter(interpreter *i) {
+	/* find the interpreter */
+	for (int k = 0; k < GC_InterpretersSz; k++) {
+		if (GC_Interpreters[k] != i) continue;
+		/* move the rest down */
+		for (int j = k + 1; j < GC_InterpretersSz; j++)
+			GC_Interpreters[j-1] = GC_Interpreters[j];
+		GC_InterpretersSz--;
+		return;
+	}
+}
+
+void GC_Check() {
+	/* keep track of the largest heap */
+	if (STORAGE_ObjectPointers.sz > GC_PeakHeap) GC_PeakHeap = STORAGE_ObjectPointers.sz;
+	/* collect if enough objects have been registered */
+	if (GC_Enabled && STORAGE_ObjectPointers.sz >= GC_Threshold)
+		GC_Collect();
+}
+
+void GC_Mark(gcMarker *m, object *o) {
+	/* ints and chars kept in the pointer aren't allocated, but an int may hold an address */
+	if (OBJECT_IsImmediate(o)) {
+		GC_Trace(m, o);
+		return;
+	}
+	/* already marked */
+	if (o == NULL || STORAGE_SetHas(&m->marked, o)) return;
+	/* mark the object */
+	STORAGE_SetAdd(&m->marked, o);
+	/* check the capacity */
+	if (m->work_sz >= m->work_cap) {
+		/* realloc list */
+		m->work = (object**)realloc(m->work, sizeof(object*) * m->work_cap * 2);
+		/* update cap */
+		m->work_cap *= 2;
+	}
+	/* trace it later */
+	m->work[m->work_sz++] = o;
+}
+
+void GC_Trace(gcMarker *m, object *o) {
+	/* int, which may be the address of an object */
+	if (OBJECT_TypeOf(o) == OBJECT_INT) {
+		object *adr = (object*)OBJECT_IntValue(o);
+		/* only registered objects are known to be real */
+		if (STORAGE_Find(adr)) GC_Mark(m, adr);
+	}
+	/* array or vector */
+	else if (OBJECT_TypeOf(o) == OBJECT_ARRAY || OBJECT_TypeOf(o) == OBJECT_VECTOR) {
+		arrayObject *a = (arrayObject*)o->value;
+		/* mark the values */
+		for (int k = 0; a->values != NULL && k < a->size; k++)
+			GC_Mark(m, a->values[k]);
+		/* ints may be addresses */
+		for (int k = 0; a->ints != NULL && k < a->size; k++)
+			if (STORAGE_Find((object*)a->ints[k])) GC_Mark(m, (object*)a->ints[k]);
+	}
+	/* map; its keys are its own copies, so only the values are marked */
+	else if (OBJECT_TypeOf(o) == OBJECT_MAP) {
+		mapObject *map = (mapObject*)o->value;
+		for (int k = 0; k < map->cap; k++)
+			if (map->entries[k].key != NULL) GC_Mark(m, map->entries[k].value);
+	}
+	/* instance */
+	else if (OBJECT_TypeOf(o) == OBJECT_INSTANCE) {
+		instance *inst = (instance*)o->value;
+		/* mark the values */
+		for (int k = 0; k < inst->st->n_of_vals; k++)
+			GC_Mark(m, inst->values[k]);
+	}
+}
+
+void GC_Collect() {
+	clock_t start = clock(); /* start of the pause */
+	gcMarker m;
+	/* size the marked set for the whole heap so that it rarely grows */
+	int cap = 256;
+	while (cap < STORAGE_ObjectPointers.sz * 2) cap *= 2;
+	STORAGE_SetInit(&m.marked, cap);
+	m.work = (object**)malloc(sizeof(object*) * 256);
+	m.work_sz = 0;
+	m.work_cap = 256;
+
+	/* mark the values of names */
+	for (int k = 0; k < NAMES_TableCap; k++)
+		if (NAMES_Table[k].name != NULL) GC_Mark(&m, NAMES_Table[k].value);
+	/* mark the stacks and frames of interpreters */
+	for (int k = 0; k < GC_InterpretersSz; k++) {
+		for (int j = 0; j < GC_Interpreters[k]->sp; j++)
+			GC_Mark(&m, GC_Interpreters[k]->stack[j]);
+		for (int j = 0; j < GC_Interpreters[k]->frame_sz; j++)
+			GC_Mark(&m, GC_Interpreters[k]->frame[j]);
+	}
+	/* mark temporary roots */
+	for (int k = 0; k < GC_RootsSz; k++)
+		GC_Mark(&m, GC_Roots[k]);
+	/* trace everything that was reached */
+	while (m.work_sz > 0)
+		GC_Trace(&m, m.work[--m.work_sz]);
+
+	/* find the objects that weren't reached */
+	object **dead = (object**)malloc(sizeof(object*) * (STORAGE_ObjectPointers.sz + 1));
+	int n_of_dead = 0;
+	for (int k = 0; k < STORAGE_ObjectPointers.cap; k++) {
+		object *o = STORAGE_ObjectPointers.keys[k];
+		/* empty slot or reached */
+		if (o == NULL || STORAGE_SetHas(&m.marked, o)) continue;
+		/* functions and structs may still be running or have instances */
+		if (o->type == OBJECT_FUNCTION || o->type == OBJECT_STRUCT) continue;
+		dead[n_of_dead++] = o;
+	}
+	/* free them while they are still registered, so arrays
+	don't free values that are freed on their own */
+	for (int k = 0; k < n_of_dead; k++)
+		OBJECT_FreeObject(dead[k]);
+	/* then unregister them */
+	for (int k = 0; k < n_of_dead; k++)
+		STORAGE_SetRemove(&STORAGE_ObjectPointers, dead[k]);
+
+	/* free lists */
+	free(dead);
+	free(m.work);
+	free(m.marked.keys);
+
+	/* collect again after the heap has doubled */
+	GC_Threshold = STORAGE_ObjectPointers.sz * 2;
+	if (GC_Threshold < GC_MIN_THRESHOLD) GC_Threshold = GC_MIN_THRESHOLD;
+
+	/* statistics */
+	double pause = (double)(clock() - start) / CLOCKS_PER_SEC;
+	GC_Collections++;
+	GC_Freed += n_of_dead;
+	GC_TotalPause += pause;
+	if (pause > GC_MaxPause) GC_MaxPause = pause;
+}
+
+void GC_PrintStats() {
+	/* heap at the end of the program counts too */
+	if (STORAGE_ObjectPointers.sz > GC_PeakHeap) GC_PeakHeap = STORAGE_ObjectPointers.sz;
+	printf("[GC] collections: %d, objects freed: %d\n", GC_Collections, GC_Freed);
+	printf("[GC] heap: %d objects, peak: %d objects\n", STORAGE_ObjectPointers.sz, GC_PeakHeap);
+	printf("[GC] pause: %.3f ms total, %.3f ms max\n", GC_TotalPause * 1000, GC_MaxPause * 1000);
+}
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
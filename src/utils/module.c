@@ -0,0 +1,238 @@
+/* see module.h for documentation */
+#include "module.h" /* our header */
+#include "filelib.h" /* reading files */
+#include "lexer.h" /* lexer */
+#include "parser.h" /* parser */
+#include "error.h" /* parser errors */
+#include "memory.h" /* memory management */
+#include "os.h" /* WINDOWS */
+#include "cache.h" /* trees on disk */
+
+#include <stdlib.h> /* malloc/realloc/free, realpath */
+#include <string.h> /* strcmp, strlen */
+#include <stdio.h> /* printf */
+#include <sys/stat.h> /* stat */
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+module **MODULE_Modules; /* loaded modules */
+int MODULE_ModulesSz; /* number of loaded modules */
+int MODULE_ModulesCap; /* capacity of loaded modules */
+char **MODULE_Paths; /* directories searched for includes */
+int MODULE_PathsSz; /* number of directories */
+int MODULE_PathsCap; /* capacity of directories */
+#endif
+
+/* absolute path of a file, in a new buffer */
+#ifdef WINDOWS
+#define MODULE_RealPath(fname) _fullpath(NULL, (fname), 0)
+#else
+#define MODULE_RealPath(fname) realpath((fname), NULL)
+#endif
+
+void MODULE_Init() {
+	/* create the lists */
+	MODULE_Modules = (module**)malloc(sizeof(module*) * 8);
+	MODULE_ModulesSz = 0;
+	MODULE_ModulesCap = 8;
+	MODULE_Paths = (char**)malloc(sizeof(char*) * 4);
+	MODULE_PathsSz = 0;
+	MODULE_PathsCap = 4;
+}
+
+void MODULE_FreeAll() {
+	/* free the modules */
+	for (int k = 0; k < MODULE_ModulesSz; k++) {
+		module *m = MODULE_Modules[k];
+		/* parsed */
+		if (m->p != NULL) PARSER_FreeParser(m->p);
+		if (m->l != NULL) LEXER_FreeLexer(m->l);
+		/* loaded from the cache */
+		if (m->cache != NULL) {
+			ARENA_FreeArena(m->a);
+			free(m->cache);
+		}
+		free(m->text);
+		free(m->path);
+		MEMORY_Free(m);
+	}
+	/* free the search path */
+	for (int k = 0; k < MODULE_PathsSz; k++)
+		free(MODULE_Paths[k]);
+	/* free the lists */
+	free(MODULE_Modules);
+	free(MODULE_Paths);
+}
+
+void MODULE_AddPath(const char *dir) {
+	/* check the capacity */
+	if (MODULE_PathsSz >= MODULE_PathsCap) {
+		/* realloc list */
+		MODULE_Paths = (char**)realloc(MODULE_Paths, sizeof(char*) * MODULE_PathsCap * 2);
+		/* update cap */
+		MODULE_PathsCap *= 2;
+	}
+	/* copy the directory */
+	char *d = (char*)malloc(strlen(dir) + 1);
+	strcpy(d, dir);
+	MODULE_Paths[MODULE_PathsSz++] = d;
+}
+
+void MODULE_AddPaths(const char *dirs) {
+	/* not set */
+	if (dirs == NULL) return;
+	/* buffer for each directory */
+	char *d = (char*)malloc(strlen(dirs) + 1);
+	while (*dirs) {
+		/* copy up to the next separator */
+		int len = 0;
+		while (dirs[len] && dirs[len] != MODULE_PATH_SEP) len++;
+		memcpy(d, dirs, len);
+		d[len] = '\0';
+		/* skip empty entries */
+		if (len > 0) MODULE_AddPath(d);
+		/* skip the separator */
+		dirs += len;
+		if (*dirs) dirs++;
+	}
+	free(d);
+}
+
+char *MODULE_Resolve(const char *fname) {
+	struct stat st;
+	/* relative to the current directory, or absolute */
+	if (stat(fname, &st) == 0 && S_ISREG(st.st_mode))
+		return MODULE_RealPath(fname);
+	/* absolute paths aren't searched for */
+	if (fname[0] == '/' || fname[0] == '\\' || (fname[0] && fname[1] == ':'))
+		return NULL;
+	/* search the directories in order */
+	for (int k = 0; k < MODULE_PathsSz; k++) {
+		/* join the directory and the filename */
+		char *path = (char*)malloc(strlen(MODULE_Paths[k]) + strlen(fname) + 2);
+		sprintf(path, "%s/%s", MODULE_Paths[k], fname);
+		/* found */
+		if (stat(path, &st) == 0 && S_ISREG(st.st_mode)) {
+			char *real = MODULE_RealPath(path);
+			free(path);
+			return real;
+		}
+		free(path);
+	}
+	/* not found */
+	return NULL;
+}
+
+module *MODULE_Load(const char *fname, int *code) {
+	/* find the file */
+	char *path = MODULE_Resolve(fname);
+	if (path == NULL) {
+		printf("File not found: %s\n", fname); /* print error */
+		*code = 2;
+		return NULL;
+	}
+	struct stat st;
+	stat(path, &st);
+	/* newest module loaded from the same path */
+	for (int k = MODULE_ModulesSz - 1; k >= 0; k--) {
+		module *m = MODULE_Modules[k];
+		if (strcmp(m->path, path)) continue;
+		/* unchanged, so the tree can be used again */
+		if (m->mtime == (long)st.st_mtime && m->size == (long)st.st_size) {
+			free(path);
+			return m;
+		}
+		/* changed; the old module is kept, since its tree may still be running */
+		break;
+	}
+
+	/* get file text */
+	file *f = open(path, "r");
+	if (f == NULL) {
+		printf("File not found: %s\n", fname); /* print error */
+		free(path);
+		*code = 2;
+		return NULL;
+	}
+	char *s = read(f);
+	close(f);
+	MEMORY_Free(f);
+
+	/* use the cached tree if the file hasn't changed since it was made */
+	lexer *l = NULL;
+	parser *p = NULL;
+	char *cache = NULL;
+	arena *a = NULL;
+	node *tree = CACHE_Enabled ? CACHE_Load(path, s, &cache, &a) : NULL;
+
+	/* otherwise, make our tokens */
+	if (tree == NULL) {
+		l = LEXER_NewLexer(s);
+		LEXER_MakeTokens(l);
+		/* the lexer has already printed its error */
+		if (l->err) {
+			LEXER_FreeLexer(l);
+			free(s);
+			free(path);
+			*code = 0;
+			return NULL;
+		}
+	}
+
+	/* parse tokens, unless there is nothing to parse */
+	if (tree == NULL && l->n_of_tokens > 1) {
+		p = PARSER_NewParser(l->tokens, l->n_of_tokens);
+		PARSER_Parse(p);
+		/* error found */
+		if (p->e != NULL || p->newNode == NULL) {
+			/* memory error */
+			if (p->e == NULL)
+				printf("Memory Error\n");
+			else {
+				/* print error string */
+				char *cs = ERROR_AsString(p->e);
+				printf("%s\n", cs);
+				free(cs);
+			}
+			PARSER_FreeParser(p);
+			LEXER_FreeLexer(l);
+			free(s);
+			free(path);
+			*code = 1; /* was error */
+			return NULL;
+		}
+		tree = p->newNode;
+		/* keep the tree for the next run */
+		if (CACHE_Enabled) CACHE_Save(path, s, tree);
+	}
+
+	/* create the module */
+	module *m = MEMORY_Malloc(module);
+	m->path = path;
+	m->mtime = (long)st.st_mtime;
+	m->size = (long)st.st_size;
+	m->text = s;
+	m->l = l;
+	m->p = p;
+	m->tree = tree;
+	m->cache = cache;
+	m->a = a;
+	m->ran = 0;
+	/* check the capacity */
+	if (MODULE_ModulesSz >= MODULE_ModulesCap) {
+		/* realloc list */
+		MODULE_Modules = (module**)realloc(MODULE_Modules, sizeof(module*) * MODULE_ModulesCap * 2);
+		/* update cap */
+		MODULE_ModulesCap *= 2;
+	}
+	/* add the module */
+	MODULE_Modules[MODULE_ModulesSz++] = m;
+	return m;
+}
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
@@ -21,68 +21,81 @@ location inside the c file. However, since I liked
 the neatness of the original system, I have put this
 inside an ifdef block.
 */
-char **NAMES_VariableNames; /* variable names list */
-int NAMES_VariableNamesSz; /* length of variable names list */
-int NAMES_VariableNamesCap; /* capacity of variable names list */
-object **NAMES_Variables; /* variable value list */
-int NAMES_VariablesSz; /* length of variable value list */
-int NAMES_VariablesCap; /* capacity of variable value list */
+nameEntry *NAMES_Table; /* table of variables */
+int NAMES_TableSz; /* number of variables in table */
+int NAMES_TableCap; /* number of slots in table, always a power of two */
 #endif
 
-void NAMES_Assign(char *name, object *o) {
-	/* reallocate if size is the same as cap */
-	if (NAMES_VariableNamesSz >= NAMES_VariableNamesCap) {
-		NAMES_VariableNames = (char**)realloc(NAMES_VariableNames, NAMES_VariableNamesCap * 2); /* realloc */
-		NAMES_Variables = (object**)realloc(NAMES_Variables, NAMES_VariablesCap * 2); /* realloc */
-		/* update capacity */
-		NAMES_VariableNamesCap *= 2;
-		NAMES_VariablesCap *= 2;
+unsigned int NAMES_Hash(const char *name) {
+	/* fnv-1a hash */
+	unsigned int h = 2166136261u;
+	while (*name) {
+		h ^= (unsigned char)*name++;
+		h *= 16777619u;
 	}
-	/* find name in list */
-	int index = NAMES_FindName(name);
-	/* copy to new buffer */
-	char *nm = (char*)malloc(strlen(name)+1);
-	strcpy(nm, name);
-	char *name_old = name;
-	name = nm;
-
-	/* name must be freed if possible, since it will later get overridden */
-	if (index != NAMES_VariableNamesSz)
-		free(NAMES_VariableNames[index]);
+	return h;
+}
 
-	/* set object at that position */
-	NAMES_VariableNames[index] = name;
-	NAMES_Variables[index] = o;
+int NAMES_FindSlot(const char *name, unsigned int hash) {
+	/* start at the hashed position and probe linearly */
+	int mask = NAMES_TableCap - 1;
+	int pos = (int)(hash & mask);
+	while (NAMES_Table[pos].name != NULL) {
+		/* the same (compare hashes first to skip most strcmps) */
+		if (NAMES_Table[pos].hash == hash && !strcmp(NAMES_Table[pos].name, name))
+			break; /* break */
+		pos = (pos + 1) & mask;
+	}
+	return pos; /* return the index */
+}
 
-	/* advance sizes if needed */
-	if (index == NAMES_VariableNamesSz) {
-		NAMES_VariableNamesSz++;
-		NAMES_VariablesSz++;
+void NAMES_Grow() {
+	nameEntry *old = NAMES_Table;
+	int old_cap = NAMES_TableCap;
+	/* allocate new table */
+	NAMES_TableCap *= 2;
+	NAMES_Table = (nameEntry*)calloc(NAMES_TableCap, sizeof(nameEntry));
+	/* move the names over */
+	for (int i = 0; i < old_cap; i++) {
+		if (old[i].name == NULL) continue;
+		NAMES_Table[NAMES_FindSlot(old[i].name, old[i].hash)] = old[i];
 	}
+	/* free the old table */
+	free(old);
 }
 
-int NAMES_FindName(char *name) {
-	int pos; /* position of name */
-	/* loop through list */
-	for (pos = 0; pos < NAMES_VariableNamesSz; pos++) {
-		/* the same */
-		if (!strcmp(NAMES_VariableNames[pos], name)) {
-			break; /* break */
-		}
+void NAMES_Assign(char *name, object *o) {
+	/* keep the table at most half full */
+	if ((NAMES_TableSz + 1) * 2 > NAMES_TableCap)
+		NAMES_Grow();
+	/* find name in table */
+	unsigned int hash = NAMES_Hash(name);
+	int index = NAMES_FindSlot(name, hash);
+	nameEntry *e = &NAMES_Table[index];
+
+	/* new name, so copy it to a new buffer */
+	if (e->name == NULL) {
+		e->name = (char*)malloc(strlen(name)+1);
+		strcpy(e->name, name);
+		e->hash = hash;
+		NAMES_TableSz++; /* advance size */
 	}
-	return pos; /* return the index */
+
+	/* set object at that position */
+	e->value = o;
+}
+
+int NAMES_FindName(char *name) {
+	/* return the index */
+	return NAMES_FindSlot(name, NAMES_Hash(name));
 }
 
 void NAMES_Init() {
-	/* assign the lists */
-	NAMES_Variables = (object**)malloc(sizeof(object*) * 100);
-	NAMES_VariableNames = (char**)malloc(sizeof(char*) * 100);
-	/* assign capacities */
-	NAMES_VariableNamesCap = 100;
-	NAMES_VariablesCap = 100;
-	/* assign sizes */
-	NAMES_VariablesSz = 0;
-	NAMES_VariableNamesSz = 0;
+	/* assign the table */
+	NAMES_TableCap = 256;
+	NAMES_Table = (nameEntry*)calloc(NAMES_TableCap, sizeof(nameEntry));
+	/* assign size */
+	NAMES_TableSz = 0;
 	/* assign constants */
 	NAMES_Assign((char*)"true", STORAGE_Register(OBJECT_NewInt(1)));
 	NAMES_Assign((char*)"false", STORAGE_Register(OBJECT_NewInt(0)));
@@ -90,43 +103,53 @@ void NAMES_Init() {
 }
 
 void NAMES_PrintNames() {
-	/* loop through names */
-	for (int i = 0; i < NAMES_VariablesSz; i++) {
+	/* loop through table */
+	for (int i = 0; i < NAMES_TableCap; i++) {
+		/* empty slot */
+		if (NAMES_Table[i].name == NULL) continue;
 		/* print name and variable */
-		printf("%s = ", NAMES_VariableNames[i]);
-		OBJECTIO_PrintObject(NAMES_Variables[i]);
+		printf("%s = ", NAMES_Table[i].name);
+		OBJECTIO_PrintObject(NAMES_Table[i].value);
 	}
 }
 
 void NAMES_FreeAll() {
 	/* free all of the names */
-	for (int i = 0; i < NAMES_VariableNamesSz; i++) {
+	for (int i = 0; i < NAMES_TableCap; i++) {
 		/* free */
-		free(NAMES_VariableNames[i]);
+		free(NAMES_Table[i].name);
 	}
-	/* free lists */
-	free(NAMES_Variables);
-	free(NAMES_VariableNames);
+	/* free table */
+	free(NAMES_Table);
 }
 
 object *NAMES_Get(char *name) {
-	/* loop */
-	int i; /* iter var */
-	for (i = 0; i < NAMES_VariableNamesSz; i++) {
-		/* the same */
-		if (!strcmp(NAMES_VariableNames[i], name)) {
-			break; /* break */
-		}
-	}
-	if (i == NAMES_VariableNamesSz) { /* failed to find variable */
+	/* find the slot */
+	int i = NAMES_FindName(name);
+	if (NAMES_Table[i].name == NULL) { /* failed to find variable */
 		return NULL;
 	}
 	else {
-		object *o = NAMES_Variables[i]; /* found variable */
+		object *o = NAMES_Table[i].value; /* found variable */
 		return o;
 	}
 }
 
+nameEntry *NAMES_Find(char *name, int *slot) {
+	/* names are never removed, so the remembered slot still has the name unless the table has grown */
+	if (*slot > 0 && *slot <= NAMES_TableCap) {
+		nameEntry *e = &NAMES_Table[*slot - 1];
+		if (e->name != NULL && !strcmp(e->name, name)) return e;
+	}
+	/* find the slot */
+	int i = NAMES_FindName(name);
+	if (NAMES_Table[i].name == NULL) /* failed to find variable */
+		return NULL;
+	/* remember it for next time */
+	*slot = i + 1;
+	return &NAMES_Table[i];
+}
+
 #ifdef __cplusplus /* c++ check */
 }
 #endif
\ No newline at end of file
@@ -1,12 +1,12 @@
 /* see run.h for documentation */
 
 #include "run.h" /* our header */
-#include "filelib.h" /* file stuff */
-#include "lexer.h" /* lexer */
-#include "parser.h" /* parser */
+#include "module.h" /* loaded files */
 #include "interpreter.h" /* interpreter */
 #include "storage.h" /* storage handling */
 #include "object.h" /* object stuff */
+#include "compiler.h" /* bytecode compiler */
+#include "vm.h" /* bytecode vm */
 
 #include <stdio.h> /* printf */
 #include <stdlib.h> /* free */
@@ -15,103 +15,83 @@
 extern "C" {
 #endif
 
+#ifdef __cplusplus
+int RUN_Mode; /* how code is executed */
+#endif
+
 int run(const char *fname) {
 	/* error code */
 	int code = 0; /* 'ok', will be 1 if error was found */
-	/* create a new file */
-	file *f = open(fname, "r");
-
-	/* failed to find file */
-	if (f == NULL) {
-		printf("File not found: %s\n", fname); /* print error */
-		return 2; /* return */
-	}
+	/* find or load the file */
+	module *m = MODULE_Load(fname, &code);
+	if (m == NULL) return code;
+	/* the file won't be run again by an include */
+	m->ran = 1;
+	/* break early if no tokens were made */
+	if (m->tree == NULL) return 0; /* default exit break code */
+	/* run the tree */
+	return RUN_Tree(m->tree);
+}
 
-	/* get file text */
-	char *s = read(f);
+int include(const char *fname) {
+	/* error code */
+	int code = 0; /* 'ok', will be 1 if error was found */
+	/* find or load the file */
+	module *m = MODULE_Load(fname, &code);
+	if (m == NULL) return code;
+	/* already run (or being run) */
+	if (m->ran) return 0;
+	m->ran = 1;
+	/* break early if no tokens were made */
+	if (m->tree == NULL) return 0; /* default exit break code */
+	/* run the tree */
+	return RUN_Tree(m->tree);
+}
 
-	/* create a lexer */
-	lexer *l = LEXER_NewLexer(s);
+int RUN_Tree(node *n) {
+	/* error code */
+	int code = 0; /* 'ok', will be 1 if error was found */
 
-	/* make our tokens */
-	LEXER_MakeTokens(l);
+	/* new interpreter */
+	interpreter *i = INTERPRETER_NewInterpreter();
 
-	/* break early if no tokens were made */
-	if (l->n_of_tokens <= 1) {
-		LEXER_FreeLexer(l);
-		return 0; /* default exit break code */
+	object *o = NULL;
+	/* compile and run on the vm */
+	if (RUN_Mode == RUN_VM) {
+		chunk *c = COMPILER_Compile(n);
+		o = VM_Execute(i, c);
+		COMPILER_FreeChunk(c);
 	}
+	/* visit node */
+	else
+		o = INTERPRETER_Visit(i, n);
+
+	/* visit method not found */
+	if (o == NULL && i->e == NULL) {
+		printf("Unknown visit method for type: %d\n", n->type); /* print error message */
+		code = 1; /* was error */
+	}
+	/* error */
+	else if (i->e != NULL) {
+		/* get error string */
+		char *cs = ERROR_AsString(i->e);
+
+		/* print error string */
+		printf("%s\n", cs);
 
-	/* no error */
-	if (!l->err) {
-		/* create new parser */
-		parser *p = PARSER_NewParser(l->tokens, l->n_of_tokens);
-		/* parse tokens */
-		PARSER_Parse(p);
-
-		/* error found */
-		if (p->e != NULL) {
-			/* get error string */
-			char *cs = ERROR_AsString(p->e);
-
-			/* print error string */
-			printf("%s\n", cs);
-
-			/* free error string */
-			free(cs);
-
-			code = 1; /* was error */
-		}
-		/* no error */
-		else {
-			/* memory error */
-			if (p->newNode == NULL) {
-				printf("Memory Error\n");
-				code = 1; /* was error */
-			}
-			/* otherwise */
-			else {
-				/* new interpreter */
-				interpreter *i = INTERPRETER_NewInterpreter();
-
-				/* visit node */
-				object *o = INTERPRETER_Visit(i, p->newNode);
-
-				/* visit method not found */
-				if (o == NULL && i->e == NULL) {
-					printf("Unknown visit method for type: %d\n", p->newNode->type); /* print error message */
-					code = 1; /* was error */
-				}
-				/* error */
-				else if (i->e != NULL) {
-					/* get error string */
-					char *cs = ERROR_AsString(i->e);
-
-					/* print error string */
-					printf("%s\n", cs);
-
-					/* free error string */
-					free(cs);
-
-					code = 1; /* was error */
-				}
-				/* otherwise */
-				else {
-					/* free object if not registered */
-					if (!STORAGE_Find(o)) OBJECT_FreeObject(o);
-				}
-
-				/* free interpreter */
-				INTERPRETER_FreeInterpreter(i);
-			}
-		}
-
-		/* free parser */
-		PARSER_FreeParser(p);
+		/* free error string */
+		free(cs);
+
+		code = 1; /* was error */
+	}
+	/* otherwise */
+	else {
+		/* free object if not registered */
+		if (!STORAGE_Find(o)) OBJECT_FreeObject(o);
 	}
 
-	/* free lexer */
-	LEXER_FreeLexer(l);
+	/* free interpreter */
+	INTERPRETER_FreeInterpreter(i);
 
 	/* return exit code */
 	return code;
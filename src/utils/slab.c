@@ -0,0 +1,96 @@
+/* see slab.h for documentation */
+#include "slab.h" /* our header */
+
+#include <stdlib.h> /* malloc/free */
+#include <stdio.h> /* printf */
+
+#ifdef __cplusplus /* c++ check */
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+slabClass SLAB_Classes[SLAB_CLASSES]; /* size classes, smallest first */
+slabBlock *SLAB_Blocks; /* every slab, newest first */
+int SLAB_Large; /* blocks too big for a class that were handed out and not freed */
+#endif
+
+void *SLAB_Alloc(int sz) {
+	/* too big for a class */
+	if (sz > SLAB_GRANULE * SLAB_CLASSES) {
+		SLAB_Large++;
+		return malloc(sz);
+	}
+	slabClass *c = &SLAB_Classes[sz > 0 ? (sz - 1) / SLAB_GRANULE : 0];
+	int block = ((sz + SLAB_GRANULE - 1) / SLAB_GRANULE) * SLAB_GRANULE;
+	if (block == 0) block = SLAB_GRANULE;
+	void *p;
+	/* freed block */
+	if (c->free != NULL) {
+		p = c->free;
+		c->free = *(void**)p;
+	}
+	/* next block of the slab */
+	else {
+		/* slab is full, so make a new one */
+		if (c->next == NULL || c->next + block > c->end) {
+			slabBlock *s = (slabBlock*)malloc(sizeof(slabBlock) + SLAB_SIZE);
+			if (s == NULL) return NULL;
+			s->next = SLAB_Blocks;
+			SLAB_Blocks = s;
+			c->next = (char*)(s + 1);
+			c->end = c->next + SLAB_SIZE;
+			c->slabs++;
+		}
+		p = (void*)c->next;
+		c->next += block;
+	}
+	/* count it */
+	if (++c->in_use > c->peak) c->peak = c->in_use;
+	return p;
+}
+
+void SLAB_Free(void *p, int sz) {
+	if (p == NULL) return;
+	/* too big for a class */
+	if (sz > SLAB_GRANULE * SLAB_CLASSES) {
+		SLAB_Large--;
+		free(p);
+		return;
+	}
+	/* put it on the list of its class */
+	slabClass *c = &SLAB_Classes[sz > 0 ? (sz - 1) / SLAB_GRANULE : 0];
+	*(void**)p = c->free;
+	c->free = p;
+	c->in_use--;
+}
+
+void SLAB_FreeAll() {
+	/* free every slab */
+	while (SLAB_Blocks != NULL) {
+		slabBlock *next = SLAB_Blocks->next;
+		free(SLAB_Blocks);
+		SLAB_Blocks = next;
+	}
+	/* nothing is handed out any more */
+	for (int k = 0; k < SLAB_CLASSES; k++) {
+		SLAB_Classes[k].free = NULL;
+		SLAB_Classes[k].next = NULL;
+		SLAB_Classes[k].end = NULL;
+		SLAB_Classes[k].in_use = 0;
+		SLAB_Classes[k].slabs = 0;
+	}
+}
+
+void SLAB_PrintStats() {
+	/* classes that have been used */
+	for (int k = 0; k < SLAB_CLASSES; k++) {
+		slabClass *c = &SLAB_Classes[k];
+		if (c->slabs == 0) continue;
+		printf("[SLAB] %d bytes: %d in use, peak: %d, slabs: %d (%d%% full)\n", (k + 1) * SLAB_GRANULE,
+			c->in_use, c->peak, c->slabs, (int)((long long)c->in_use * (k + 1) * SLAB_GRANULE * 100 / ((long long)c->slabs * SLAB_SIZE)));
+	}
+}
+
+#ifdef __cplusplus /* c++ check */
+}
+#endif
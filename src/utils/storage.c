@@ -10,114 +10,193 @@ extern "C" {
 #endif
 
 #ifdef __cplusplus
-object **STORAGE_ObjectPointers; /* object pointers */
-object **STORAGE_FreedPointers; /* freed pointers */
-int STORAGE_ObjectPointersSz; /* size of object pointers list */
-int STORAGE_FreedPointersSz; /* size of freed pointers list */
-int STORAGE_ObjectPointersCap; /* capacity of object pointers list */
-int STORAGE_FreedPointersCap; /* capacity of freed pointers list */
+pointerSet STORAGE_ObjectPointers; /* object pointers */
+pointerSet STORAGE_FreedPointers; /* freed pointers */
+pointerSet STORAGE_SharedPointers; /* shared string literals (see OBJECT_Literal) */
+arena *STORAGE_Scratch; /* region for temporaries */
 #endif
 
+void STORAGE_SetInit(pointerSet *set, int cap) {
+	/* create the slots */
+	set->keys = (object**)calloc(cap, sizeof(object*));
+	/* assign size and capacity */
+	set->sz = 0;
+	set->cap = cap;
+}
+
+unsigned int STORAGE_Hash(object *o) {
+	/* objects are aligned, so the low bits carry nothing */
+	unsigned int h = (unsigned int)((size_t)o >> 3);
+	/* mix the bits (fibonacci hashing) */
+	return h * 2654435769u;
+}
+
+int STORAGE_SetSlot(pointerSet *set, object *o) {
+	/* start at the hashed position and probe linearly */
+	int mask = set->cap - 1;
+	int pos = (int)(STORAGE_Hash(o) & mask);
+	while (set->keys[pos] != NULL && set->keys[pos] != o)
+		pos = (pos + 1) & mask;
+	return pos; /* return the index */
+}
+
+void STORAGE_SetAdd(pointerSet *set, object *o) {
+	/* NULL marks empty slots, so it can't be added */
+	if (o == NULL) return;
+	/* keep the set at most half full */
+	if ((set->sz + 1) * 2 > set->cap) {
+		object **old = set->keys;
+		int old_cap = set->cap;
+		/* allocate new slots */
+		STORAGE_SetInit(set, old_cap * 2);
+		/* move the pointers over */
+		for (int i = 0; i < old_cap; i++) {
+			if (old[i] == NULL) continue;
+			set->keys[STORAGE_SetSlot(set, old[i])] = old[i];
+			set->sz++;
+		}
+		/* free old slots */
+		free(old);
+	}
+	/* find slot */
+	int i = STORAGE_SetSlot(set, o);
+	/* already in set */
+	if (set->keys[i] != NULL) return;
+	/* add the pointer */
+	set->keys[i] = o;
+	set->sz++;
+}
+
+int STORAGE_SetHas(pointerSet *set, object *o) {
+	/* NULL marks empty slots, so it is never in a set */
+	if (o == NULL) return 0;
+	/* truth value */
+	return set->keys[STORAGE_SetSlot(set, o)] != NULL;
+}
+
+void STORAGE_SetRemove(pointerSet *set, object *o) {
+	int mask = set->cap - 1;
+	int i = STORAGE_SetSlot(set, o);
+	/* not in set */
+	if (set->keys[i] == NULL) return;
+	/* empty the slot */
+	set->keys[i] = NULL;
+	set->sz--;
+	/* move back any pointers that probed past the emptied slot */
+	int j = i;
+	for (;;) {
+		j = (j + 1) & mask;
+		if (set->keys[j] == NULL) break;
+		/* where the pointer wants to be */
+		int k = (int)(STORAGE_Hash(set->keys[j]) & mask);
+		/* leave it if its wanted slot is cyclically between i and j */
+		if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j)) continue;
+		/* move it into the hole */
+		set->keys[i] = set->keys[j];
+		set->keys[j] = NULL;
+		i = j;
+	}
+}
+
 object *STORAGE_Register(object *o) {
-	/* check if we need to resize */
-	if (STORAGE_ObjectPointersSz >= STORAGE_ObjectPointersCap) {
-		/* reallocate */
-		STORAGE_ObjectPointers = (object**)realloc(STORAGE_ObjectPointers, sizeof(object*) * STORAGE_ObjectPointersCap * 2);
-		/* update the size */
-		STORAGE_ObjectPointersCap *= 2;
+	/* ints and chars kept in the pointer aren't allocated, so there is nothing to keep track of */
+	if (OBJECT_IsImmediate(o)) return o;
+	/* shared literals stay with their node, and temporaries go with the
+	scratch region; whatever keeps the value gets its own copy */
+	if (o != NULL && (o->flags & (OBJECT_SHARED | OBJECT_SCRATCH))) {
+		/* int too big to be kept in the pointer */
+		if (o->type == OBJECT_INT)
+			o = OBJECT_NewInt(OBJECT_IntValue(o));
+		else {
+			object *copy = OBJECT_NewStringLen(OBJECT_StringChars(o), OBJECT_StringLen(o));
+			OBJECT_String(copy)->hash = OBJECT_String(o)->hash;
+			o = copy;
+		}
 	}
+	/* the address may belong to an object that was freed before */
+	STORAGE_SetRemove(&STORAGE_FreedPointers, o);
 	/* add the item */
-	STORAGE_ObjectPointers[STORAGE_ObjectPointersSz++] = o;
+	STORAGE_SetAdd(&STORAGE_ObjectPointers, o);
 	return o;
 }
 
 void STORAGE_Free(object *o) {
 	/* free the actual object */
 	OBJECT_FreeObject(o);
-	/* check for it in our freed pointers list */
-	int i;
-	for (i = 0; i < STORAGE_FreedPointersSz; i++) {
-		/* are they same */
-		if (STORAGE_FreedPointers[i] == o) {
-			/* break */
-			break;
-		}
-	}
-	if (i == STORAGE_FreedPointersSz) {
-		/* check if we need to resize */
-		if (STORAGE_FreedPointersSz >= STORAGE_FreedPointersCap) {
-			/* reallocate */
-			STORAGE_FreedPointers = (object**)realloc(STORAGE_FreedPointers, sizeof(object*) * STORAGE_FreedPointersCap * 2);
-			/* update the size */
-			STORAGE_FreedPointersCap *= 2;
-		}
-		/* add the pointer to the list */
-		STORAGE_FreedPointers[STORAGE_FreedPointersSz] = o;
-		/* advance the size */
-		STORAGE_FreedPointersSz++;
-	}
+	/* no longer registered, so STORAGE_FreeAll won't free it again */
+	STORAGE_SetRemove(&STORAGE_ObjectPointers, o);
+	/* add the pointer to our freed pointers list */
+	STORAGE_SetAdd(&STORAGE_FreedPointers, o);
 }
 
 void STORAGE_FreeAll() {
 	/* loop through object pointers */
-	for (int i = 0; i < STORAGE_ObjectPointersSz; i++) {
+	for (int i = 0; i < STORAGE_ObjectPointers.cap; i++) {
+		object *o = STORAGE_ObjectPointers.keys[i];
+		/* empty slot */
+		if (o == NULL) continue;
 		/* freed pointers aren't being used and probably won't.
 		as a result, we are just going to immediately free the object
 		from memory. */
 		/* debug print object */
 		#if defined(STORAGE_DEBUG) && STORAGE_DEBUG == 1
-		printf("[DEBUG LOG] Pointer: %p, %d: ", STORAGE_ObjectPointers[i], STORAGE_ObjectPointers[i]->type);
-		OBJECTIO_PrintObject(STORAGE_ObjectPointers[i]);
+		printf("[DEBUG LOG] Pointer: %p, %d: ", o, o->type);
+		OBJECTIO_PrintObject(o);
 		#endif
 		/* free object */
-		OBJECT_FreeObject(STORAGE_ObjectPointers[i]);
+		OBJECT_FreeObject(o);
 		/* debug, print stuff */
 		#if defined(STORAGE_DEBUG) && STORAGE_DEBUG == 1
-		printf("[DEBUG LOG] Freed %p.\n", STORAGE_ObjectPointers[i]);
+		printf("[DEBUG LOG] Freed %p.\n", o);
 		#endif
 	}
+	/* free the scratch region */
+	ARENA_FreeArena(STORAGE_Scratch);
 	/* free the freed pointers list */
-	free(STORAGE_FreedPointers);
+	free(STORAGE_FreedPointers.keys);
+	/* free the shared literals list; the literals themselves are freed by OBJECT_FreeLiterals */
+	free(STORAGE_SharedPointers.keys);
 	/* free the object list */
-	free(STORAGE_ObjectPointers);
+	free(STORAGE_ObjectPointers.keys);
 }
 
 void STORAGE_Init() {
-	/* create the lists */
-	STORAGE_ObjectPointers = (object**)malloc(sizeof(object*) * 100);
-	STORAGE_FreedPointers = (object**)malloc(sizeof(object*) * 100);
-	/* create length variables */
-	STORAGE_FreedPointersSz = 0;
-	STORAGE_ObjectPointersSz = 0;
-	/* create capacity variables */
-	STORAGE_FreedPointersCap = 100;
-	STORAGE_ObjectPointersCap = 100;
+	/* create the sets */
+	STORAGE_SetInit(&STORAGE_ObjectPointers, 256);
+	STORAGE_SetInit(&STORAGE_FreedPointers, 256);
+	STORAGE_SetInit(&STORAGE_SharedPointers, 64);
+	/* create the scratch region */
+	STORAGE_Scratch = ARENA_NewArena(ARENA_BLOCK_SIZE);
 }
 
 int STORAGE_Find(object *o) {
-	/* loop through list */
-	int i; /* iter var */
-	int found = 0; /* found var */
-	for (i = 0; i < STORAGE_ObjectPointersSz; i++) {
-		/* if equal */
-		if (STORAGE_ObjectPointers[i] == o) {
-			found = 1; /* found it */
-		}
-	}
+	/* never registered */
+	if (OBJECT_IsImmediate(o)) return 0;
 	/* truth value */
-	return found;
+	return STORAGE_SetHas(&STORAGE_ObjectPointers, o);
+}
+
+void STORAGE_Discard(object *o) {
+	/* nothing to free, or the scratch region or a node has it */
+	if (o == NULL || OBJECT_IsImmediate(o) || (o->flags & (OBJECT_SHARED | OBJECT_SCRATCH)))
+		return;
+	/* something else still holds it */
+	if (STORAGE_SetHas(&STORAGE_ObjectPointers, o))
+		return;
+	/* free object */
+	OBJECT_FreeObject(o);
 }
 
 int STORAGE_FindFreed(object *o) {
-	/* loop through list */
-	int i; /* iter var */
-	for (i = 0; i < STORAGE_FreedPointersSz; i++) {
-		/* if equal */
-		if (STORAGE_FreedPointers[i] == o)
-			break; /* quit loop */
-	}
 	/* truth value */
-	return (int)(!i == STORAGE_FreedPointersSz);
+	return STORAGE_SetHas(&STORAGE_FreedPointers, o);
+}
+
+int STORAGE_FindShared(object *o) {
+	/* never shared */
+	if (OBJECT_IsImmediate(o)) return 0;
+	/* truth value */
+	return STORAGE_SetHas(&STORAGE_SharedPointers, o);
 }
 
 #ifdef __cplusplus /* c++ check */